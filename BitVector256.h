@@ -2,7 +2,7 @@
 #define BitVector256_h
 
 #include <stdint.h> // uint16_t
-#include <cstring> // memset
+#include <cstring> // memset, memcmp
 
 class BitVector256 {
 public:
@@ -37,6 +37,87 @@ public:
         memset(vector, ~0, sizeof(vector));
     }
 
+    /**
+     * Raw access to the 16 bits stored for a given x, where bit y corresponds to get(x, y).
+     * Out of range x values read as all zeros and are ignored when written.
+     */
+    inline uint16_t getBits(unsigned x) const {
+        return (x < VECTOR_SIZE) ? vector[x] : 0;
+    }
+
+    inline void setBits(unsigned x, uint16_t bits) {
+        if(x < VECTOR_SIZE)
+            vector[x] = bits;
+    }
+
+    /**
+     * Transposes the vector in place such that get(x, y) returns what get(y, x) used to.
+     * Swaps progressively smaller off-diagonal blocks instead of moving single bits.
+     */
+    inline void transpose() {
+        uint16_t mask = 0x00FF;
+
+        for(unsigned j = VECTOR_SIZE / 2; j != 0; j >>= 1, mask ^= (uint16_t)(mask << j)) {
+            for(unsigned k = 0; k < VECTOR_SIZE; k = ((k | j) + 1) & ~j) {
+                const uint16_t t = ((vector[k] >> j) ^ vector[k | j]) & mask;
+                vector[k]     ^= (uint16_t)(t << j);
+                vector[k | j] ^= t;
+            }
+        }
+    }
+
+    /**
+     * Reverses the order of the 16 bits, so bit 0 becomes bit 15 and vice versa.
+     */
+    static inline uint16_t reverseBits(uint16_t bits) {
+        bits = (uint16_t)(((bits >> 1) & 0x5555) | ((bits & 0x5555) << 1));
+        bits = (uint16_t)(((bits >> 2) & 0x3333) | ((bits & 0x3333) << 2));
+        bits = (uint16_t)(((bits >> 4) & 0x0F0F) | ((bits & 0x0F0F) << 4));
+        return (uint16_t)((bits >> 8) | (bits << 8));
+    }
+
+    /**
+     * Number of consecutive set bits starting from bit 0.
+     */
+    static inline unsigned countTrailingOnes(uint32_t bits) {
+#if defined(__GNUC__)
+        return (~bits == 0) ? 32 : (unsigned)__builtin_ctz(~bits);
+#else
+        unsigned count = 0;
+        while(count < 32 && (bits & (1u << count)) != 0) {
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * Index of the lowest set bit, bits must not be 0.
+     */
+    static inline unsigned countTrailingZeros(uint32_t bits) {
+        return countTrailingOnes(~bits);
+    }
+
+    inline bool operator==(const BitVector256 &other) const {
+        return memcmp(vector, other.vector, sizeof(vector)) == 0;
+    }
+
+    inline bool operator!=(const BitVector256 &other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * Orders vectors by their raw bits, x = 0 being the most significant.
+     */
+    inline bool operator<(const BitVector256 &other) const {
+        for(unsigned x = 0; x < VECTOR_SIZE; x++) {
+            if(vector[x] != other.vector[x])
+                return vector[x] < other.vector[x];
+        }
+
+        return false;
+    }
+
 protected:
     uint16_t vector[(VECTOR_SIZE * VECTOR_SIZE) / (8*sizeof(uint16_t))];
 };
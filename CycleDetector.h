@@ -0,0 +1,126 @@
+#ifndef CycleDetector_h
+#define CycleDetector_h
+
+#include <vector>
+#include <stdint.h> // uint64_t
+
+/**
+ * Brent style cycle detection over a stream of state hashes.
+ *
+ * The current candidate state is replaced at power of two intervals, so a repeat
+ * of it is found within a small multiple of the cycle's start plus its length.
+ *
+ * States that fully describe the run (exact) are reported as a cycle as soon as one repeats.
+ * Partial states may repeat by coincidence, so the most recent states are also kept and a
+ * repeat only counts once the last confirmSteps states (and at least one full period) all
+ * match the states one period earlier. Periods longer than maxPeriod are not recognized.
+ */
+class CycleDetector {
+public:
+    CycleDetector(unsigned long confirmSteps = 0, unsigned long maxPeriod = 4096)
+    : confirmSteps(confirmSteps), maxPeriod(maxPeriod), historyMask(historySize(confirmSteps, maxPeriod) - 1) {
+        reset();
+    }
+
+    inline void reset() {
+        steps = 0;
+        tortoise = 0;
+        tortoiseStep = 0;
+        power = 1;
+        history.clear();
+    }
+
+    /**
+     * Feeds the next state into the detector.
+     * @param state: hash of the current state
+     * @param exact: true if equal hashes mean the run will repeat itself from here on
+     * @return true once a cycle has been detected
+     */
+    inline bool step(uint64_t state, bool exact) {
+        const unsigned long t = steps++;
+
+        if(!exact) {
+            remember(state, t);
+        }
+
+        if(t == 0) {
+            tortoise = state;
+            tortoiseStep = t;
+            return false;
+        }
+
+        if(state == tortoise) {
+            if(exact || repeatsWithPeriod(t, t - tortoiseStep)) {
+                return true;
+            }
+        }
+
+        // Keep doubling even after coincidental repeats, so the window
+        // eventually spans the real period however many short repeats it contains
+        if(t - tortoiseStep >= power) {
+            tortoise = state;
+            tortoiseStep = t;
+            power *= 2;
+        }
+
+        return false;
+    }
+
+protected:
+    const unsigned long confirmSteps;
+    const unsigned long maxPeriod;
+
+    unsigned long steps;
+    uint64_t tortoise;
+    unsigned long tortoiseStep;
+    unsigned long power;
+
+    // Ring buffer of the most recent partial states. It only grows as far as the
+    // run gets, so short runs never pay for the whole window.
+    std::vector<uint64_t> history;
+    const unsigned long historyMask;
+
+    /**
+     * @return smallest power of two that holds enough states to confirm the longest period
+     */
+    static inline unsigned long historySize(unsigned long confirmSteps, unsigned long maxPeriod) {
+        const unsigned long needed = 2 * maxPeriod + confirmSteps + 1;
+        unsigned long size = 1;
+
+        while(size < needed) {
+            size *= 2;
+        }
+
+        return size;
+    }
+
+    inline void remember(uint64_t state, unsigned long t) {
+        while(history.size() <= t && history.size() <= historyMask) {
+            history.push_back(0);
+        }
+
+        history[t & historyMask] = state;
+    }
+
+    /**
+     * @return true if every state of the last max(confirmSteps, period) steps up to t
+     *         equals the state one period before it
+     */
+    inline bool repeatsWithPeriod(unsigned long t, unsigned long period) const {
+        const unsigned long window = (confirmSteps > period) ? confirmSteps : period;
+
+        if(period > maxPeriod || t + 1 < window + period) {
+            return false;
+        }
+
+        for(unsigned long i = 0; i < window; i++) {
+            if(history[(t - i) & historyMask] != history[(t - i - period) & historyMask]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif
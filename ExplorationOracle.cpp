@@ -0,0 +1,178 @@
+#include <cstring> // memset
+
+#include "ExplorationOracle.h"
+#include "Maze.h"
+#include "WallMap.h"
+
+namespace {
+    const unsigned LEN = MazeDefinitions::MAZE_LEN;
+
+    // Every bit of the wall planes that is not part of the outer boundary.
+    // NS bit 0 of each column is the south edge and EW column 0 is the west edge.
+    const uint16_t INTERIOR_NS = 0xFFFE;
+    const uint16_t INTERIOR_EW = 0xFFFF;
+
+    inline uint16_t interiorBits(bool ns, unsigned x) {
+        if(ns) {
+            return INTERIOR_NS;
+        }
+
+        return (x == 0) ? 0 : INTERIOR_EW;
+    }
+
+    inline unsigned pathThrough(uint8_t fromStart, uint8_t toGoal) {
+        return (unsigned)fromStart + 1 + toGoal;
+    }
+}
+
+ExplorationOracle::ExplorationOracle(Maze &truth)
+: truthNS(truth.wallNS), truthEW(truth.wallEW),
+  candidateCount(1), knownLength(UNREACHABLE), optimisticLength(0),
+  completeStep(NOT_COMPLETE), updated(false) {
+    BitVector256 start;
+    start.set(0, 0);
+
+    flood(truthNS, truthEW, start, fromStart);
+    flood(truthNS, truthEW, goalCells(), toGoal);
+    trueLength = toGoal[0][0];
+}
+
+bool ExplorationOracle::update(const WallMap &known, unsigned long step) {
+    const BitVector256 &knownNS = known.getKnownNS();
+    const BitVector256 &knownEW = known.getKnownEW();
+
+    // Most steps sense nothing new, and an unchanged map gives an unchanged answer
+    if(updated && known == lastKnown) {
+        return isComplete();
+    }
+
+    lastKnown = known;
+    updated = true;
+
+    const BitVector256 goal = goalCells();
+    DistanceMap distances;
+
+    flood(known.getOpenNS(), known.getOpenEW(), goal, distances);
+    knownLength = distances[0][0];
+
+    BitVector256 optimisticNS, optimisticEW;
+    BitVector256 unknownNS, unknownEW;
+
+    for(unsigned x = 0; x < LEN; x++) {
+        unknownNS.setBits(x, (uint16_t)(~knownNS.getBits(x) & interiorBits(true, x)));
+        unknownEW.setBits(x, (uint16_t)(~knownEW.getBits(x) & interiorBits(false, x)));
+        optimisticNS.setBits(x, (uint16_t)(known.getOpenNS().getBits(x) | unknownNS.getBits(x)));
+        optimisticEW.setBits(x, (uint16_t)(known.getOpenEW().getBits(x) | unknownEW.getBits(x)));
+    }
+
+    flood(optimisticNS, optimisticEW, goal, distances);
+    optimisticLength = distances[0][0];
+
+    // An unknown open wall between cells a and b matters if the real shortest path
+    // through it, in either direction, beats everything the mouse knows of
+    candidatesNS.clearAll();
+    candidatesEW.clearAll();
+    candidateCount = 0;
+
+    for(unsigned x = 0; x < LEN; x++) {
+        uint16_t ns = unknownNS.getBits(x) & truthNS.getBits(x);
+        uint16_t ew = unknownEW.getBits(x) & truthEW.getBits(x);
+
+        while(ns) {
+            const unsigned y = BitVector256::countTrailingZeros(ns);
+            ns &= (uint16_t)(ns - 1);
+
+            // Wall between (x, y-1) and (x, y)
+            if(pathThrough(fromStart[x][y-1], toGoal[x][y]) < knownLength ||
+               pathThrough(fromStart[x][y], toGoal[x][y-1]) < knownLength) {
+                candidatesNS.set(x, y);
+                candidateCount++;
+            }
+        }
+
+        while(ew) {
+            const unsigned y = BitVector256::countTrailingZeros(ew);
+            ew &= (uint16_t)(ew - 1);
+
+            // Wall between (x-1, y) and (x, y)
+            if(pathThrough(fromStart[x-1][y], toGoal[x][y]) < knownLength ||
+               pathThrough(fromStart[x][y], toGoal[x-1][y]) < knownLength) {
+                candidatesEW.set(x, y);
+                candidateCount++;
+            }
+        }
+    }
+
+    if(candidateCount == 0 && completeStep == NOT_COMPLETE) {
+        completeStep = step;
+    }
+
+    return isComplete();
+}
+
+void ExplorationOracle::flood(const BitVector256 &openNS, const BitVector256 &openEW,
+                              const BitVector256 &sources, DistanceMap &distances) {
+    memset(distances, UNREACHABLE, sizeof(distances));
+
+    BitVector256 visited = sources;
+    BitVector256 frontier = sources;
+
+    for(unsigned distance = 0; distance < UNREACHABLE; distance++) {
+        BitVector256 next;
+        bool any = false;
+
+        for(unsigned x = 0; x < LEN; x++) {
+            uint16_t cells = frontier.getBits(x);
+
+            if(cells == 0) {
+                continue;
+            }
+
+            any = true;
+
+            // Record the distance of every cell in this column of the frontier
+            for(uint16_t bits = cells; bits; bits &= (uint16_t)(bits - 1)) {
+                distances[x][BitVector256::countTrailingZeros(bits)] = (uint8_t)distance;
+            }
+
+            // North through NS bit y+1, south through NS bit y
+            uint16_t reached = (uint16_t)(((cells & (openNS.getBits(x) >> 1)) << 1) |
+                                          ((cells & openNS.getBits(x)) >> 1));
+            next.setBits(x, (uint16_t)(next.getBits(x) | reached));
+
+            // East through EW column x+1, west through EW column x
+            if(x + 1 < LEN) {
+                next.setBits(x + 1, (uint16_t)(next.getBits(x + 1) | (cells & openEW.getBits(x + 1))));
+            }
+
+            if(x > 0) {
+                next.setBits(x - 1, (uint16_t)(next.getBits(x - 1) | (cells & openEW.getBits(x))));
+            }
+        }
+
+        if(!any) {
+            break;
+        }
+
+        for(unsigned x = 0; x < LEN; x++) {
+            const uint16_t fresh = (uint16_t)(next.getBits(x) & ~visited.getBits(x));
+            frontier.setBits(x, fresh);
+            visited.setBits(x, (uint16_t)(visited.getBits(x) | fresh));
+        }
+    }
+}
+
+BitVector256 ExplorationOracle::goalCells() {
+    const unsigned midpoint = LEN / 2;
+    BitVector256 goal;
+
+    goal.set(midpoint, midpoint);
+
+    if(LEN % 2 == 0) {
+        goal.set(midpoint - 1, midpoint);
+        goal.set(midpoint, midpoint - 1);
+        goal.set(midpoint - 1, midpoint - 1);
+    }
+
+    return goal;
+}
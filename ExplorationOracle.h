@@ -0,0 +1,116 @@
+#ifndef ExplorationOracle_h
+#define ExplorationOracle_h
+
+#include <stdint.h> // uint8_t
+
+#include "BitVector256.h"
+#include "MazeDefinitions.h"
+#include "WallMap.h"
+
+class Maze;
+
+/**
+ * Tells when a mouse has explored enough of a maze to know an optimal path to the center.
+ *
+ * Given the walls a mouse has sensed and the real maze, the oracle finds every
+ * still unknown wall that is actually open and lies on a path from the start to the
+ * center shorter than the best path made of known open walls. Once there are none left,
+ * the mouse already knows an optimal path and any further searching is wasted.
+ *
+ * Path lengths are counted in cells moved and found with a breadth first flood that
+ * advances a whole bitboard of cells per step.
+ */
+class ExplorationOracle {
+public:
+    static const unsigned UNREACHABLE = 0xFF;
+    static const unsigned long NOT_COMPLETE = ~0UL;
+
+    /**
+     * Takes a non-const maze so that PathFinders, which are only ever handed a const Maze,
+     * can not build an oracle to read the real walls through it.
+     */
+    ExplorationOracle(Maze &truth);
+
+    /**
+     * Re-evaluates the oracle against the walls the mouse knows at the given step.
+     * @return true if the mouse knows an optimal path
+     */
+    bool update(const WallMap &known, unsigned long step);
+
+    inline bool isComplete() const {
+        return candidateCount == 0;
+    }
+
+    /**
+     * @return the first step passed to update at which the mouse knew an optimal path, or NOT_COMPLETE
+     */
+    inline unsigned long getCompleteStep() const {
+        return completeStep;
+    }
+
+    /**
+     * @return number of unknown walls that could still shorten the best known path
+     */
+    inline unsigned getCandidateCount() const {
+        return candidateCount;
+    }
+
+    /**
+     * Unknown walls that could still shorten the best known path, in Maze's wall plane layout.
+     */
+    inline const BitVector256 &getCandidatesNS() const { return candidatesNS; }
+    inline const BitVector256 &getCandidatesEW() const { return candidatesEW; }
+
+    /**
+     * @return length of the shortest path in the real maze
+     */
+    inline unsigned getTrueLength() const {
+        return trueLength;
+    }
+
+    /**
+     * @return length of the shortest path using only walls known to be open, or UNREACHABLE
+     */
+    inline unsigned getKnownLength() const {
+        return knownLength;
+    }
+
+    /**
+     * @return length of the shortest path if every unknown wall were open
+     */
+    inline unsigned getOptimisticLength() const {
+        return optimisticLength;
+    }
+
+private:
+    typedef uint8_t DistanceMap[MazeDefinitions::MAZE_LEN][MazeDefinitions::MAZE_LEN];
+
+    BitVector256 truthNS;
+    BitVector256 truthEW;
+
+    // Distances in the real maze, computed once
+    DistanceMap fromStart;
+    DistanceMap toGoal;
+    unsigned trueLength;
+
+    BitVector256 candidatesNS;
+    BitVector256 candidatesEW;
+    unsigned candidateCount;
+    unsigned knownLength;
+    unsigned optimisticLength;
+    unsigned long completeStep;
+
+    // Map from the last update, to skip work when nothing new was sensed
+    WallMap lastKnown;
+    bool updated;
+
+    /**
+     * Fills in the distance from the nearest source cell to every cell, moving only through open walls.
+     */
+    static void flood(const BitVector256 &openNS, const BitVector256 &openEW,
+                      const BitVector256 &sources, DistanceMap &distances);
+
+    static BitVector256 goalCells();
+};
+
+#endif
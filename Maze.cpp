@@ -1,10 +1,18 @@
 #include <iostream>
+#include <chrono>
 #include "Maze.h"
+#include "CycleDetector.h"
+#include "ExplorationOracle.h"
+#include "WallMap.h"
+#include "MazeSymmetry.h"
 
 #define ARRAY_SIZE(a) (sizeof(a)/sizeof(*a))
 
+// Reading the clock every step would be a measurable share of a healthy run
+static const unsigned long TIME_CHECK_INTERVAL = 1024;
+
 Maze::Maze(MazeDefinitions::MazeEncodingName name, PathFinder *pathFinder)
-: heading(NORTH), pathFinder(pathFinder), mouseX(0), mouseY(0) {
+: heading(NORTH), pathFinder(pathFinder), movementLog(NULL), mouseX(0), mouseY(0) {
     if(name >= MazeDefinitions::MAZE_NAME_MAX) {
         name = MazeDefinitions::MAZE_CAMM_2012;
     }
@@ -42,6 +50,9 @@ Maze::Maze(MazeDefinitions::MazeEncodingName name, PathFinder *pathFinder)
             }
         }
     }
+
+    wallEWRows = wallEW;
+    wallEWRows.transpose();
 }
 
 bool Maze::isOpen(unsigned x, unsigned y, Dir d) const {
@@ -76,6 +87,47 @@ void Maze::setOpen(unsigned x, unsigned y, Dir d) {
     }
 }
 
+unsigned Maze::openDistance(unsigned x, unsigned y, Dir d, unsigned maxCells) const {
+    const unsigned len = MazeDefinitions::MAZE_LEN;
+    uint32_t walls;
+
+    if(x >= len || y >= len) {
+        return 0;
+    }
+
+    // Shift the wall on side d of (x, y) down to bit 0 with the walls further along
+    // the ray above it. Bits past the edge of the maze are closed, so the run of
+    // set bits always ends at the boundary.
+    switch(d) {
+        case NORTH:
+            walls = (uint32_t)wallNS.getBits(x) >> (y + 1);
+            break;
+        case SOUTH:
+            walls = (uint32_t)BitVector256::reverseBits(wallNS.getBits(x)) >> (len - 1 - y);
+            break;
+        case EAST:
+            walls = (uint32_t)wallEWRows.getBits(y) >> (x + 1);
+            break;
+        case WEST:
+            walls = (uint32_t)BitVector256::reverseBits(wallEWRows.getBits(y)) >> (len - 1 - x);
+            break;
+        case INVALID:
+        default:
+            return 0;
+    }
+
+    const unsigned open = BitVector256::countTrailingOnes(walls);
+    return (open < maxCells) ? open : maxCells;
+}
+
+uint64_t Maze::canonicalHash() const {
+    BitVector256 ns = wallNS;
+    BitVector256 ew = wallEW;
+
+    MazeSymmetry::canonicalize(ns, ew);
+    return MazeSymmetry::hash(ns, ew);
+}
+
 void Maze::moveForward() {
     if(! isOpen(mouseX, mouseY, heading)) {
         throw "Mouse crashed!";
@@ -107,11 +159,24 @@ void Maze::moveBackward() {
     heading = oldHeading;
 }
 
-void Maze::start() {
+RunResult Maze::start(const RunLimits &limits) {
     MouseMovement nextMovement;
+    CycleDetector cycleDetector(limits.cycleConfirmSteps, limits.cycleMaxPeriod);
+    WallMap knownWalls;
+    unsigned long steps = 0;
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point startTime = Clock::now();
 
     if(!pathFinder) {
-        return;
+        return RunFinished;
+    }
+
+    // A PathFinder handed a map before the run may already know an optimal path
+    if(limits.explorationOracle && pathFinder->saveMap(knownWalls)) {
+        if(limits.explorationOracle->update(knownWalls, steps) && limits.stopWhenExplored) {
+            return RunExplored;
+        }
     }
 
     while(Finish != (nextMovement = pathFinder->nextMovement(mouseX, mouseY, *this))) {
@@ -137,12 +202,50 @@ void Maze::start() {
                     break;
                 case Finish:
                 default:
-                    return;
+                    return RunFinished;
             }
-        } catch (std::string str) {
+
+            if(movementLog) {
+                movementLog->push_back(nextMovement);
+            }
+        } catch (const char *str) {
             std::cerr << str << std::endl;
+            return RunCrashed;
+        }
+
+        steps++;
+
+        if(limits.maxSteps != 0 && steps >= limits.maxSteps) {
+            return RunStepLimit;
+        }
+
+        if(limits.maxSeconds > 0 && steps % TIME_CHECK_INTERVAL == 0) {
+            const std::chrono::duration<double> elapsed = Clock::now() - startTime;
+
+            if(elapsed.count() >= limits.maxSeconds) {
+                return RunTimeLimit;
+            }
+        }
+
+        if(limits.detectCycles) {
+            uint64_t finderHash = 0;
+            const bool exact = pathFinder->getStateHash(finderHash);
+            const uint64_t position = (uint64_t)mouseX | ((uint64_t)mouseY << 16) | ((uint64_t)heading << 32);
+
+            if((exact || limits.detectHashlessCycles) &&
+               cycleDetector.step(position ^ (finderHash * 0x9e3779b97f4a7c15ULL), exact)) {
+                return RunCycleDetected;
+            }
+        }
+
+        if(limits.explorationOracle && pathFinder->saveMap(knownWalls)) {
+            if(limits.explorationOracle->update(knownWalls, steps) && limits.stopWhenExplored) {
+                return RunExplored;
+            }
         }
     }
+
+    return RunFinished;
 }
 
 std::string Maze::draw(const size_t infoLen) const {
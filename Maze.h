@@ -2,24 +2,49 @@
 #define Maze_h
 
 #include <string>
+#include <vector>
+#include <stdint.h> // uint64_t
 
 #include "BitVector256.h"
 #include "MazeDefinitions.h"
 #include "Dir.h"
 #include "PathFinder.h"
+#include "RunLimits.h"
+#include "SensorModel.h"
 
 class Maze {
 protected:
     BitVector256 wallNS;
     BitVector256 wallEW;
+
+    // wallEW transposed, so each row of walls can be scanned as a single word
+    BitVector256 wallEWRows;
+
     Dir heading;
     PathFinder *pathFinder;
+    std::vector<MouseMovement> *movementLog;
     unsigned mouseX;
     unsigned mouseY;
 
+    // Range sensors every PathFinder on this maze senses with
+    SensorModel sensorModel;
+
     bool isOpen(unsigned x, unsigned y, Dir d) const;
     void setOpen(unsigned x, unsigned y, Dir d);
 
+    /**
+     * Counts how many walls in a row are open, starting with the wall on side d of cell (x, y)
+     * and continuing in the same direction, using a single bit scan.
+     * Only the maze's SensorModel may use it, PathFinders only get to see what the sensors see.
+     * @param maxCells: stop counting after this many open walls
+     */
+    unsigned openDistance(unsigned x, unsigned y, Dir d, unsigned maxCells = MazeDefinitions::MAZE_LEN) const;
+
+    friend class SensorModel;
+
+    // Compares what the mouse knows against the real walls
+    friend class ExplorationOracle;
+
     void moveForward();
     void moveBackward();
 
@@ -50,11 +75,55 @@ public:
         return !isOpen(mouseX, mouseY, clockwise(heading));
     }
 
+    /**
+     * Reads the maze's range sensors from the mouse's current cell and heading.
+     */
+    inline void sense(SensorReading &reading) const {
+        sensorModel.sense(*this, reading);
+    }
+
+    /**
+     * Replaces the range sensors read by sense(), for all PathFinders run on this maze.
+     */
+    inline void setSensorModel(const SensorModel &sensors) {
+        sensorModel = sensors;
+    }
+
+    inline const SensorModel &getSensorModel() const {
+        return sensorModel;
+    }
+
+    /**
+     * 64-bit hash of the maze's walls in canonical form.
+     * Rotated or mirrored copies of the same layout hash to the same value.
+     */
+    uint64_t canonicalHash() const;
+
+    /**
+     * Puts the mouse back in the start cell facing north, as between runs of a contest.
+     */
+    inline void resetMouse() {
+        mouseX = 0;
+        mouseY = 0;
+        heading = NORTH;
+    }
+
+    /**
+     * Records every movement the mouse performs during start() into the given vector,
+     * e.g. to be scored by a MotionProfile afterwards. Pass NULL to stop recording.
+     */
+    inline void setMovementLog(std::vector<MouseMovement> *log) {
+        movementLog = log;
+    }
+
     /**
      * Start running the mouse through the maze.
-     * Terminates when the PathFinder's nextMovement method returns MouseMovement::Finish.
+     * Terminates when the PathFinder's nextMovement method returns MouseMovement::Finish,
+     * or earlier if the run is stuck in a loop or goes over any of the given limits.
+     * @param limits: step, time and cycle detection limits for this run
+     * @return the reason the run ended
      */
-    void start();
+    RunResult start(const RunLimits &limits = RunLimits());
 
     /**
      * This function draws the maze using ASCII characters.
@@ -65,6 +134,12 @@ public:
      * @return string of rendered maze
      */
     std::string draw(const size_t infoLen = 4) const;
+
+private:
+    // Not copyable, a PathFinder could otherwise copy the const Maze it is handed
+    // and build an ExplorationOracle from the copy
+    Maze(const Maze &);
+    Maze &operator=(const Maze &);
 };
 
 #endif
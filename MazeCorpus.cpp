@@ -0,0 +1,32 @@
+#include "MazeCorpus.h"
+#include "Maze.h"
+
+bool MazeCorpus::add(MazeDefinitions::MazeEncodingName name) {
+    const uint64_t hash = Maze(name, NULL).canonicalHash();
+
+    if(byHash.find(hash) != byHash.end()) {
+        return false;
+    }
+
+    byHash[hash] = name;
+    uniqueMazes.push_back(name);
+    uniqueHashes.push_back(hash);
+    return true;
+}
+
+unsigned MazeCorpus::addAll() {
+    unsigned duplicates = 0;
+
+    for(unsigned i = 0; i < MazeDefinitions::MAZE_NAME_MAX; i++) {
+        if(!add((MazeDefinitions::MazeEncodingName)i)) {
+            duplicates++;
+        }
+    }
+
+    return duplicates;
+}
+
+MazeDefinitions::MazeEncodingName MazeCorpus::find(uint64_t hash) const {
+    std::map<uint64_t, MazeDefinitions::MazeEncodingName>::const_iterator it = byHash.find(hash);
+    return (it != byHash.end()) ? it->second : MazeDefinitions::MAZE_NAME_MAX;
+}
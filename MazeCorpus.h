@@ -0,0 +1,55 @@
+#ifndef MazeCorpus_h
+#define MazeCorpus_h
+
+#include <map>
+#include <vector>
+#include <stdint.h> // uint64_t
+
+#include "MazeDefinitions.h"
+
+/**
+ * A set of maze layouts deduplicated by their canonical hash.
+ *
+ * Mazes that are rotated or mirrored copies of one already in the corpus
+ * are not added again, so a batch over the corpus never simulates the same layout twice.
+ */
+class MazeCorpus {
+public:
+    /**
+     * Adds the maze to the corpus unless an equivalent layout is already present.
+     * @return true if the maze was added, false if it was a duplicate
+     */
+    bool add(MazeDefinitions::MazeEncodingName name);
+
+    /**
+     * Adds every built in maze definition in order.
+     * @return number of duplicates that were skipped
+     */
+    unsigned addAll();
+
+    /**
+     * @return the maze first added with the given canonical hash, or MAZE_NAME_MAX if there is none
+     */
+    MazeDefinitions::MazeEncodingName find(uint64_t hash) const;
+
+    /**
+     * @return canonical hash of every maze in the corpus, in the order they were added
+     */
+    inline const std::vector<uint64_t> &hashes() const {
+        return uniqueHashes;
+    }
+
+    /**
+     * @return the distinct mazes in the order they were added
+     */
+    inline const std::vector<MazeDefinitions::MazeEncodingName> &mazes() const {
+        return uniqueMazes;
+    }
+
+protected:
+    std::map<uint64_t, MazeDefinitions::MazeEncodingName> byHash;
+    std::vector<MazeDefinitions::MazeEncodingName> uniqueMazes;
+    std::vector<uint64_t> uniqueHashes;
+};
+
+#endif
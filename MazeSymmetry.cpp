@@ -0,0 +1,120 @@
+#include "MazeSymmetry.h"
+#include "MazeDefinitions.h"
+
+namespace {
+    // Walls are stored on the near side of each cell, so mirroring a plane
+    // across its wall axis maps index i onto MAZE_LEN - i rather than MAZE_LEN - 1 - i.
+    // Index 0 is the outer boundary and always stays closed.
+    void flipWallIndices(BitVector256 &plane) {
+        const unsigned len = MazeDefinitions::MAZE_LEN;
+        BitVector256 flipped;
+
+        for(unsigned x = 1; x < len; x++) {
+            flipped.setBits(x, plane.getBits(len - x));
+        }
+
+        plane = flipped;
+    }
+
+    void reverseIndices(BitVector256 &plane) {
+        const unsigned len = MazeDefinitions::MAZE_LEN;
+
+        for(unsigned x = 0; x < len / 2; x++) {
+            const uint16_t tmp = plane.getBits(x);
+            plane.setBits(x, plane.getBits(len - 1 - x));
+            plane.setBits(len - 1 - x, tmp);
+        }
+    }
+
+    void flipWallBits(BitVector256 &plane) {
+        for(unsigned x = 0; x < MazeDefinitions::MAZE_LEN; x++) {
+            plane.setBits(x, (uint16_t)(BitVector256::reverseBits(plane.getBits(x)) << 1));
+        }
+    }
+
+    void reverseBitsOfAll(BitVector256 &plane) {
+        for(unsigned x = 0; x < MazeDefinitions::MAZE_LEN; x++) {
+            plane.setBits(x, BitVector256::reverseBits(plane.getBits(x)));
+        }
+    }
+
+    inline bool lessThan(const BitVector256 &ns1, const BitVector256 &ew1,
+                         const BitVector256 &ns2, const BitVector256 &ew2) {
+        if(ns1 != ns2) {
+            return ns1 < ns2;
+        }
+
+        return ew1 < ew2;
+    }
+}
+
+void MazeSymmetry::apply(unsigned transform, BitVector256 &wallNS, BitVector256 &wallEW) {
+    if(transform & FLIP_X) {
+        reverseIndices(wallNS);
+        flipWallIndices(wallEW);
+    }
+
+    if(transform & FLIP_Y) {
+        flipWallBits(wallNS);
+        reverseBitsOfAll(wallEW);
+    }
+
+    if(transform & TRANSPOSE) {
+        // A wall below a cell becomes a wall to the left of the mirrored cell and vice versa
+        wallNS.transpose();
+        wallEW.transpose();
+
+        const BitVector256 tmp = wallNS;
+        wallNS = wallEW;
+        wallEW = tmp;
+    }
+}
+
+unsigned MazeSymmetry::canonicalize(BitVector256 &wallNS, BitVector256 &wallEW) {
+    BitVector256 bestNS = wallNS;
+    BitVector256 bestEW = wallEW;
+    unsigned bestTransform = IDENTITY;
+
+    for(unsigned transform = IDENTITY + 1; transform < TRANSFORM_MAX; transform++) {
+        BitVector256 ns = wallNS;
+        BitVector256 ew = wallEW;
+        apply(transform, ns, ew);
+
+        if(lessThan(ns, ew, bestNS, bestEW)) {
+            bestNS = ns;
+            bestEW = ew;
+            bestTransform = transform;
+        }
+    }
+
+    wallNS = bestNS;
+    wallEW = bestEW;
+    return bestTransform;
+}
+
+uint64_t MazeSymmetry::hash(const BitVector256 &wallNS, const BitVector256 &wallEW) {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    // FNV-1a over 64-bit words, four 16-bit rows at a time
+    for(unsigned x = 0; x < BitVector256::VECTOR_SIZE; x += 4) {
+        uint64_t ns = 0, ew = 0;
+
+        for(unsigned i = 0; i < 4; i++) {
+            ns |= (uint64_t)wallNS.getBits(x + i) << (16 * i);
+            ew |= (uint64_t)wallEW.getBits(x + i) << (16 * i);
+        }
+
+        h = (h ^ ns) * prime;
+        h = (h ^ ew) * prime;
+    }
+
+    // Final avalanche so that nearby layouts do not share low bits
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
@@ -0,0 +1,47 @@
+#ifndef MazeSymmetry_h
+#define MazeSymmetry_h
+
+#include <stdint.h> // uint64_t
+
+#include "BitVector256.h"
+
+/**
+ * Symmetries of a maze's wall planes.
+ *
+ * Wall planes use the same layout as Maze: a set bit in wallNS at (x, y) means the wall
+ * between cells (x, y-1) and (x, y) is open, and a set bit in wallEW at (x, y) means the
+ * wall between cells (x-1, y) and (x, y) is open.
+ */
+namespace MazeSymmetry {
+    /**
+     * Each of the 8 rotations/reflections of a square maze is a combination
+     * of these flags, applied to the cell coordinates in the order listed.
+     */
+    enum Transform {
+        IDENTITY  = 0,
+        FLIP_X    = 1 << 0, // x -> MAZE_LEN - 1 - x
+        FLIP_Y    = 1 << 1, // y -> MAZE_LEN - 1 - y
+        TRANSPOSE = 1 << 2, // (x, y) -> (y, x)
+
+        TRANSFORM_MAX = 1 << 3
+    };
+
+    /**
+     * Applies the transform (a combination of Transform flags) to the wall planes in place.
+     */
+    void apply(unsigned transform, BitVector256 &wallNS, BitVector256 &wallEW);
+
+    /**
+     * Replaces the wall planes with the smallest of their 8 symmetric variants,
+     * so that rotated or mirrored copies of a maze end up with identical planes.
+     * @return the transform that was applied to reach the canonical form
+     */
+    unsigned canonicalize(BitVector256 &wallNS, BitVector256 &wallEW);
+
+    /**
+     * 64-bit content hash of the wall planes as they are, without canonicalizing them first.
+     */
+    uint64_t hash(const BitVector256 &wallNS, const BitVector256 &wallEW);
+}
+
+#endif
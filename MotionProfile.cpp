@@ -0,0 +1,147 @@
+#include <algorithm> // min
+#include <cmath>
+
+#include "MotionProfile.h"
+
+MotionProfile::MotionProfile(const MotionParameters &params)
+: params(params) {
+    const double pi = 3.14159265358979323846;
+
+    // Quarter circle through the turning cell, entering and leaving at the middle of its walls
+    arcTime = (pi * params.cellLength / 4) / params.turnSpeed;
+
+    for(unsigned halfCells = 0; halfCells <= MAX_TABLE_HALF_CELLS; halfCells++) {
+        const double distance = halfCells * params.cellLength / 2;
+
+        for(unsigned entry = 0; entry < 2; entry++) {
+            for(unsigned exit = 0; exit < 2; exit++) {
+                straightTable[halfCells][entry][exit] = computeStraight(distance,
+                                                                        entry ? params.turnSpeed : 0,
+                                                                        exit ? params.turnSpeed : 0);
+            }
+        }
+    }
+}
+
+double MotionProfile::straightTime(unsigned halfCells, bool entryTurning, bool exitTurning) const {
+    if(halfCells <= MAX_TABLE_HALF_CELLS) {
+        return straightTable[halfCells][entryTurning ? 1 : 0][exitTurning ? 1 : 0];
+    }
+
+    return computeStraight(halfCells * params.cellLength / 2,
+                           entryTurning ? params.turnSpeed : 0,
+                           exitTurning ? params.turnSpeed : 0);
+}
+
+double MotionProfile::computeStraight(double distance, double entrySpeed, double exitSpeed) const {
+    const double a = params.acceleration;
+    const double b = params.deceleration;
+    const double vMax = params.maxSpeed;
+    const double v0 = std::min(entrySpeed, vMax);
+    const double v1 = std::min(exitSpeed, vMax);
+
+    if(distance <= 0) {
+        return 0;
+    }
+
+    // Too short to reach the exit speed, accelerate the whole way
+    if(v1 > v0 && v1 * v1 > v0 * v0 + 2 * a * distance) {
+        return (std::sqrt(v0 * v0 + 2 * a * distance) - v0) / a;
+    }
+
+    // Too short to slow down to the exit speed, brake the whole way
+    if(v0 > v1 && v0 * v0 - 2 * b * distance > v1 * v1) {
+        return (v0 - std::sqrt(v0 * v0 - 2 * b * distance)) / b;
+    }
+
+    const double peakSquared = (2 * a * b * distance + b * v0 * v0 + a * v1 * v1) / (a + b);
+
+    // Triangular profile, top speed is never reached
+    if(peakSquared <= vMax * vMax) {
+        const double peak = std::sqrt(peakSquared);
+        return (peak - v0) / a + (peak - v1) / b;
+    }
+
+    const double accelDistance = (vMax * vMax - v0 * v0) / (2 * a);
+    const double decelDistance = (vMax * vMax - v1 * v1) / (2 * b);
+    const double cruiseDistance = distance - accelDistance - decelDistance;
+
+    return (vMax - v0) / a + (vMax - v1) / b + cruiseDistance / vMax;
+}
+
+double MotionProfile::time(const std::vector<MouseMovement> &movements) const {
+    double total = 0;
+
+    // Straight in progress, in half cells. A smooth turn takes half of the next cell,
+    // so this can briefly drop below zero until the following MoveForward is seen.
+    int halfCells = 0;
+    bool entryTurning = false;
+    bool lastWasForward = false;
+
+    for(size_t i = 0; i < movements.size(); i++) {
+        const MouseMovement movement = movements[i];
+
+        if(movement == MoveForward) {
+            halfCells += 2;
+            lastWasForward = true;
+            continue;
+        }
+
+        if(movement == Wait) {
+            total += params.waitTime;
+            continue;
+        }
+
+        const bool isTurn = (movement == TurnClockwise || movement == TurnCounterClockwise);
+
+        if(isTurn && params.smoothTurns && lastWasForward &&
+           i + 1 < movements.size() && movements[i+1] == MoveForward) {
+            total += straightTime(halfCells - 1, entryTurning, true) + arcTime;
+            halfCells = -1;
+            entryTurning = true;
+            lastWasForward = false;
+            continue;
+        }
+
+        // Anything else brings the mouse to a stop first
+        if(halfCells > 0) {
+            total += straightTime(halfCells, entryTurning, false);
+        }
+
+        halfCells = 0;
+        entryTurning = false;
+        lastWasForward = false;
+
+        switch(movement) {
+            case TurnClockwise:
+            case TurnCounterClockwise:
+                total += params.turnInPlaceTime;
+                break;
+            case TurnAround:
+                total += params.turnAroundTime;
+                break;
+            case MoveBackward: {
+                size_t end = i;
+                while(end < movements.size() && movements[end] == MoveBackward) {
+                    end++;
+                }
+
+                total += straightTime(2 * (end - i), false, false);
+                i = end - 1;
+                break;
+            }
+            case Finish:
+                return total;
+            case MoveForward:
+            case Wait:
+            default:
+                break;
+        }
+    }
+
+    if(halfCells > 0) {
+        total += straightTime(halfCells, entryTurning, false);
+    }
+
+    return total;
+}
@@ -0,0 +1,91 @@
+#ifndef MotionProfile_h
+#define MotionProfile_h
+
+#include <vector>
+
+#include "PathFinder.h"
+
+/**
+ * Physical parameters of the mouse used to turn movements into time.
+ * Distances are in meters, speeds in m/s, accelerations in m/s^2 and times in seconds.
+ */
+struct MotionParameters {
+    // Length of one maze cell
+    double cellLength;
+
+    // Top straight line speed
+    double maxSpeed;
+
+    double acceleration;
+    double deceleration;
+
+    // Speed held through a smooth 90 degree turn
+    double turnSpeed;
+
+    // Time to rotate in place by 90 and 180 degrees while stopped
+    double turnInPlaceTime;
+    double turnAroundTime;
+
+    // Time charged when the PathFinder waits
+    double waitTime;
+
+    // Whether a turn between two straights is taken as a smooth arc instead of stopping to turn in place
+    bool smoothTurns;
+
+    MotionParameters()
+    : cellLength(0.18), maxSpeed(2.0), acceleration(4.0), deceleration(4.0),
+      turnSpeed(0.6), turnInPlaceTime(0.25), turnAroundTime(0.4), waitTime(0), smoothTurns(true) {
+    }
+};
+
+/**
+ * Timing model that scores a sequence of movements in seconds.
+ *
+ * Straights follow a trapezoidal accelerate/cruise/decelerate profile. A turn between two
+ * forward straights is taken as a quarter circle arc at turnSpeed, which cuts half a cell
+ * off of each straight. Any other turn stops the mouse and rotates it in place.
+ *
+ * The time for every straight length and entry/exit speed is computed once
+ * when the profile is created, so scoring a path only adds up table entries.
+ */
+class MotionProfile {
+public:
+    MotionProfile(const MotionParameters &params = MotionParameters());
+
+    inline const MotionParameters &getParameters() const {
+        return params;
+    }
+
+    /**
+     * @return simulated time in seconds to perform the movements in order, starting and ending at rest
+     */
+    double time(const std::vector<MouseMovement> &movements) const;
+
+    /**
+     * Time for a straight of the given number of half cells.
+     * @param entryTurning: true if the straight begins coming out of a smooth turn instead of from rest
+     * @param exitTurning: true if the straight ends going into a smooth turn instead of stopping
+     */
+    double straightTime(unsigned halfCells, bool entryTurning, bool exitTurning) const;
+
+    /**
+     * Time to go through a single smooth 90 degree turn.
+     */
+    inline double smoothTurnTime() const {
+        return arcTime;
+    }
+
+protected:
+    // Longest straight kept in the lookup table, longer ones are computed on the fly
+    static const unsigned MAX_TABLE_HALF_CELLS = 64;
+
+    const MotionParameters params;
+    double arcTime;
+
+    // Indexed by half cells, then entry speed, then exit speed (0 = stopped, 1 = turning)
+    double straightTable[MAX_TABLE_HALF_CELLS + 1][2][2];
+
+    double computeStraight(double distance, double entrySpeed, double exitSpeed) const;
+};
+
+#endif
@@ -2,8 +2,10 @@
 #define PathFinder_h
 
 #include <string>
+#include <stdint.h> // uint64_t
 
 class Maze;
+class WallMap;
 
 enum MouseMovement {
     MoveForward,            // Move in the direction mouse is facing
@@ -34,6 +36,57 @@ public:
      */
     virtual MouseMovement nextMovement(unsigned x, unsigned y, const Maze &maze) = 0;
 
+    /**
+     * Function used to detect runs that are stuck in a loop.
+     *
+     * If the PathFinder can summarize all of the state that affects its decisions
+     * into a hash, the maze can stop a looping run as soon as the mouse returns to
+     * the same cell and heading with the same PathFinder state. The hash must change
+     * while the PathFinder makes progress without moving, e.g. between Waits.
+     *
+     * Runs of PathFinders without a hash are only checked for loops if
+     * RunLimits::detectHashlessCycles is set, and are then stopped once the mouse
+     * has repeated the same loop for RunLimits::cycleConfirmSteps movements.
+     *
+     * @param hash: set to the hash of the current state if one is provided
+     * @return true if a hash was provided
+     */
+    virtual bool getStateHash(uint64_t &hash) {
+        (void)hash;
+        return false;
+    }
+
+    /**
+     * Called by a Session before each of its runs, after the mouse has been put back at the start.
+     * @param run: index of the run within the session, 0 being the first
+     */
+    virtual void beginRun(unsigned run) {
+        (void)run;
+    }
+
+    /**
+     * Function used to keep what the PathFinder has learned about the maze between
+     * runs of a Session, or between processes by saving it to disk.
+     *
+     * @param map: filled in with every wall sensed so far
+     * @return true if the PathFinder keeps a map
+     */
+    virtual bool saveMap(WallMap &map) {
+        (void)map;
+        return false;
+    }
+
+    /**
+     * Function used to restore a map previously produced by saveMap,
+     * so that the PathFinder can skip exploring parts it already knows.
+     *
+     * @return true if the PathFinder accepted the map
+     */
+    virtual bool loadMap(const WallMap &map) {
+        (void)map;
+        return false;
+    }
+
     /**
      * Function used to draw extra info on the maze.
      *
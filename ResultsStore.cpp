@@ -0,0 +1,405 @@
+#include <cstring> // memcpy
+
+#include "ResultsStore.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const uint32_t FOOTER_MAGIC = 0x53524d4d; // "MMRS"
+    const uint32_t TRAILER_MAGIC = 0x46524d4d; // "MMRF"
+    const uint32_t VERSION = 2;
+
+    // Footer offset, footer size and magic at the very end of the file
+    const size_t TRAILER_SIZE = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+    // Widest columns come first so every column stays aligned within a block
+    const size_t ROW_BYTES = 3 * sizeof(uint64_t) + 4 * sizeof(uint32_t) + sizeof(uint8_t);
+
+    inline uint64_t blockBytes(uint64_t rows) {
+        return (rows * ROW_BYTES + 7) & ~(uint64_t)7;
+    }
+
+    void layoutColumns(const unsigned char *base, size_t rows, ResultColumns &columns) {
+        columns.rows     = rows;
+        columns.mazeHash = (const uint64_t *)base;
+        columns.simTime  = (const double *)(columns.mazeHash + rows);
+        columns.wallTime = columns.simTime + rows;
+        columns.finder   = (const uint32_t *)(columns.wallTime + rows);
+        columns.steps    = columns.finder + rows;
+        columns.turns    = columns.steps + rows;
+        columns.exploredStep = columns.turns + rows;
+        columns.status   = (const uint8_t *)(columns.exploredStep + rows);
+    }
+
+    template<typename T>
+    void put(std::vector<unsigned char> &out, const T &value) {
+        const unsigned char *bytes = (const unsigned char *)&value;
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    bool get(const unsigned char *&in, const unsigned char *end, T &value) {
+        if((size_t)(end - in) < sizeof(T)) {
+            return false;
+        }
+
+        memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return true;
+    }
+
+    /**
+     * Reads the trailer at the end of a store of the given size.
+     * @return false if the trailer is missing or points outside the file
+     */
+    bool parseTrailer(const unsigned char *trailer, uint64_t fileSize, uint64_t &footerOffset, uint32_t &footerSize) {
+        const unsigned char *end = trailer + TRAILER_SIZE;
+        uint32_t magic = 0;
+
+        if(!get(trailer, end, footerOffset) || !get(trailer, end, footerSize) || !get(trailer, end, magic)) {
+            return false;
+        }
+
+        return magic == TRAILER_MAGIC && footerOffset + footerSize + TRAILER_SIZE == fileSize;
+    }
+
+    bool parseFooter(const unsigned char *footer, uint32_t footerSize, uint64_t footerOffset,
+                     std::vector<ResultBlockInfo> &blocks, std::vector<std::string> &finderNames) {
+        const unsigned char *in = footer;
+        const unsigned char *end = footer + footerSize;
+        uint32_t magic = 0, version = 0, blockCount = 0, finderCount = 0;
+
+        if(!get(in, end, magic) || !get(in, end, version) ||
+           !get(in, end, blockCount) || !get(in, end, finderCount)) {
+            return false;
+        }
+
+        if(magic != FOOTER_MAGIC || version != VERSION) {
+            return false;
+        }
+
+        blocks.clear();
+        finderNames.clear();
+
+        for(uint32_t i = 0; i < blockCount; i++) {
+            ResultBlockInfo block;
+            uint32_t reserved = 0;
+
+            if(!get(in, end, block.offset) || !get(in, end, block.rows) || !get(in, end, reserved)) {
+                return false;
+            }
+
+            if(block.offset % 8 != 0 || block.offset + blockBytes(block.rows) > footerOffset) {
+                return false;
+            }
+
+            blocks.push_back(block);
+        }
+
+        for(uint32_t i = 0; i < finderCount; i++) {
+            uint32_t length = 0;
+
+            if(!get(in, end, length) || (size_t)(end - in) < length) {
+                return false;
+            }
+
+            finderNames.push_back(std::string((const char *)in, length));
+            in += length;
+        }
+
+        return true;
+    }
+}
+
+ResultsWriter::ResultsWriter()
+: file(NULL), dataEnd(0), footerDirty(false) {
+}
+
+ResultsWriter::~ResultsWriter() {
+    close();
+}
+
+bool ResultsWriter::open(const std::string &path) {
+    close();
+
+    blocks.clear();
+    finderNames.clear();
+    dataEnd = 0;
+    footerDirty = false;
+
+    file = fopen(path.c_str(), "r+b");
+    if(!file) {
+        file = fopen(path.c_str(), "w+b");
+        footerDirty = true;
+        return file != NULL;
+    }
+
+    if(fseek(file, 0, SEEK_END) != 0) {
+        close();
+        return false;
+    }
+
+    const long fileSize = ftell(file);
+    if(fileSize == 0) {
+        footerDirty = true;
+        return true;
+    }
+
+    // Reuse the reader's recovery so rows flushed before an interrupted write are kept
+    ResultsReader reader;
+    if(!reader.open(path)) {
+        fclose(file);
+        file = NULL;
+        return false;
+    }
+
+    blocks = reader.blocks;
+    finderNames = reader.finderNames;
+    dataEnd = reader.validSize;
+    return true;
+}
+
+bool ResultsWriter::close() {
+    if(!file) {
+        return true;
+    }
+
+    const bool flushed = flush();
+    const bool closed = (fclose(file) == 0);
+    file = NULL;
+
+    return flushed && closed;
+}
+
+uint32_t ResultsWriter::finderId(const std::string &name) {
+    for(size_t i = 0; i < finderNames.size(); i++) {
+        if(finderNames[i] == name) {
+            return (uint32_t)i;
+        }
+    }
+
+    finderNames.push_back(name);
+    footerDirty = true;
+    return (uint32_t)(finderNames.size() - 1);
+}
+
+bool ResultsWriter::append(const ResultRow &row) {
+    mazeHash.push_back(row.mazeHash);
+    simTime.push_back(row.simTime);
+    wallTime.push_back(row.wallTime);
+    finder.push_back(row.finder);
+    steps.push_back(row.steps);
+    turns.push_back(row.turns);
+    exploredStep.push_back(row.exploredStep);
+    status.push_back(row.status);
+
+    if(mazeHash.size() >= BLOCK_ROWS) {
+        return flush();
+    }
+
+    return true;
+}
+
+bool ResultsWriter::flush() {
+    if(!file) {
+        return false;
+    }
+
+    const size_t rows = mazeHash.size();
+
+    if(rows == 0 && !footerDirty) {
+        return fflush(file) == 0;
+    }
+
+    // Everything goes after the last trailer, so a store cut short at any point
+    // still ends in, or can be scanned back to, a complete footer
+    if(fseek(file, (long)dataEnd, SEEK_SET) != 0) {
+        return false;
+    }
+
+    if(rows > 0) {
+        const uint64_t padding[1] = { 0 };
+        const uint64_t offset = (dataEnd + 7) & ~(uint64_t)7;
+        const uint64_t bytes = blockBytes(rows);
+
+        const size_t alignBytes = (size_t)(offset - dataEnd);
+        const size_t paddingBytes = (size_t)(bytes - rows * ROW_BYTES);
+
+        const bool ok = fwrite(padding, 1, alignBytes, file) == alignBytes &&
+                        fwrite(mazeHash.data(), sizeof(uint64_t), rows, file) == rows &&
+                        fwrite(simTime.data(),  sizeof(double),   rows, file) == rows &&
+                        fwrite(wallTime.data(), sizeof(double),   rows, file) == rows &&
+                        fwrite(finder.data(),   sizeof(uint32_t), rows, file) == rows &&
+                        fwrite(steps.data(),    sizeof(uint32_t), rows, file) == rows &&
+                        fwrite(turns.data(),    sizeof(uint32_t), rows, file) == rows &&
+                        fwrite(exploredStep.data(), sizeof(uint32_t), rows, file) == rows &&
+                        fwrite(status.data(),   sizeof(uint8_t),  rows, file) == rows &&
+                        fwrite(padding, 1, paddingBytes, file) == paddingBytes;
+
+        if(!ok) {
+            return false;
+        }
+
+        ResultBlockInfo block;
+        block.offset = offset;
+        block.rows = (uint32_t)rows;
+        blocks.push_back(block);
+        dataEnd = offset + bytes;
+
+        mazeHash.clear();
+        simTime.clear();
+        wallTime.clear();
+        finder.clear();
+        steps.clear();
+        turns.clear();
+        exploredStep.clear();
+        status.clear();
+    }
+
+    if(!writeFooter() || fflush(file) != 0) {
+        return false;
+    }
+
+    footerDirty = false;
+    return true;
+}
+
+bool ResultsWriter::writeFooter() {
+    std::vector<unsigned char> footer;
+    const uint32_t reserved = 0;
+
+    put(footer, FOOTER_MAGIC);
+    put(footer, VERSION);
+    put(footer, (uint32_t)blocks.size());
+    put(footer, (uint32_t)finderNames.size());
+
+    for(size_t i = 0; i < blocks.size(); i++) {
+        put(footer, blocks[i].offset);
+        put(footer, blocks[i].rows);
+        put(footer, reserved);
+    }
+
+    for(size_t i = 0; i < finderNames.size(); i++) {
+        put(footer, (uint32_t)finderNames[i].size());
+        footer.insert(footer.end(), finderNames[i].begin(), finderNames[i].end());
+    }
+
+    const uint32_t footerSize = (uint32_t)footer.size();
+    put(footer, dataEnd);
+    put(footer, footerSize);
+    put(footer, TRAILER_MAGIC);
+
+    if(fwrite(footer.data(), 1, footer.size(), file) != footer.size()) {
+        return false;
+    }
+
+    dataEnd += footer.size();
+    return true;
+}
+
+ResultsReader::ResultsReader()
+: data(NULL), size(0), validSize(0), mapped(false) {
+}
+
+ResultsReader::~ResultsReader() {
+    close();
+}
+
+bool ResultsReader::open(const std::string &path) {
+    close();
+
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size < (off_t)TRAILER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if(mapping == MAP_FAILED) {
+        return false;
+    }
+
+    data = (const unsigned char *)mapping;
+    size = (size_t)info.st_size;
+    mapped = true;
+#else
+    FILE *file = fopen(path.c_str(), "rb");
+    if(!file) {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if(fileSize < (long)TRAILER_SIZE) {
+        fclose(file);
+        return false;
+    }
+
+    unsigned char *buffer = new unsigned char[fileSize];
+    const bool read = fread(buffer, 1, fileSize, file) == (size_t)fileSize;
+    fclose(file);
+
+    data = buffer;
+    size = (size_t)fileSize;
+
+    if(!read) {
+        close();
+        return false;
+    }
+#endif
+
+    // Normally the trailer is at the very end, but if a writer died part way
+    // through a flush, fall back to the last complete footer before that
+    for(size_t end = size; end >= TRAILER_SIZE; end--) {
+        uint64_t footerOffset = 0;
+        uint32_t footerSize = 0;
+
+        if(parseTrailer(data + end - TRAILER_SIZE, end, footerOffset, footerSize) &&
+           parseFooter(data + footerOffset, footerSize, footerOffset, blocks, finderNames)) {
+            validSize = end;
+            return true;
+        }
+    }
+
+    close();
+    return false;
+}
+
+void ResultsReader::close() {
+    if(data) {
+#ifndef _WIN32
+        if(mapped) {
+            munmap((void *)data, size);
+        }
+#else
+        delete[] data;
+#endif
+    }
+
+    data = NULL;
+    size = 0;
+    validSize = 0;
+    mapped = false;
+    blocks.clear();
+    finderNames.clear();
+}
+
+void ResultsReader::getBlock(size_t index, ResultColumns &columns) const {
+    const ResultBlockInfo &block = blocks[index];
+    layoutColumns(data + block.offset, block.rows, columns);
+}
@@ -0,0 +1,181 @@
+#ifndef ResultsStore_h
+#define ResultsStore_h
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h> // fixed width integers
+
+/**
+ * Append-only columnar storage for batch results.
+ *
+ * A store is a single file that only ever has blocks of rows and footers appended to it.
+ * Each block holds every column of its rows as a contiguous fixed width array, so a
+ * query can scan a single column without touching the rest. Every flush appends a new
+ * footer indexing all blocks so far along with the finder names, which rows refer to by
+ * id. If a writer dies part way through a flush, readers fall back to the last complete footer.
+ *
+ * Every writer owns its own file, so batch workers never share a lock; a query
+ * simply reads all of their files. Values are stored in native byte order.
+ */
+
+/**
+ * One simulated run.
+ */
+struct ResultRow {
+    // Value of exploredStep when the mouse never knew an optimal path
+    static const uint32_t NOT_EXPLORED = 0xFFFFFFFF;
+
+    uint64_t mazeHash;      // Maze::canonicalHash of the maze that was run
+    double simTime;         // Seconds according to the MotionProfile
+    double wallTime;        // Seconds the simulation took to compute
+    uint32_t finder;        // Id returned by ResultsWriter::finderId
+    uint32_t steps;         // Movements performed
+    uint32_t turns;         // Turning movements performed
+    uint32_t exploredStep;  // Movements until the mouse knew an optimal path, or NOT_EXPLORED
+    uint8_t status;         // RunResult the run ended with
+
+    ResultRow()
+    : mazeHash(0), simTime(0), wallTime(0), finder(0), steps(0), turns(0), exploredStep(NOT_EXPLORED), status(0) {
+    }
+};
+
+/**
+ * Column arrays of one block of a store, valid as long as the ResultsReader stays open.
+ */
+struct ResultColumns {
+    size_t rows;
+    const uint64_t *mazeHash;
+    const double *simTime;
+    const double *wallTime;
+    const uint32_t *finder;
+    const uint32_t *steps;
+    const uint32_t *turns;
+    const uint32_t *exploredStep;
+    const uint8_t *status;
+};
+
+/**
+ * Location of a block within a store.
+ */
+struct ResultBlockInfo {
+    uint64_t offset;
+    uint32_t rows;
+};
+
+/**
+ * Appends rows to a store, buffering a block of rows at a time.
+ * Not thread safe; use one writer (and file) per thread.
+ */
+class ResultsWriter {
+public:
+    static const unsigned BLOCK_ROWS = 4096;
+
+    ResultsWriter();
+    ~ResultsWriter();
+
+    /**
+     * Opens a store for appending, creating it if it does not exist.
+     * Rows of an existing store are kept and new blocks are added after them.
+     * @return false if the file could not be opened or is not a valid store
+     */
+    bool open(const std::string &path);
+
+    /**
+     * Writes out buffered rows and closes the file.
+     * @return false if anything failed to be written
+     */
+    bool close();
+
+    /**
+     * @return the id to store in ResultRow::finder for the given PathFinder name
+     */
+    uint32_t finderId(const std::string &name);
+
+    /**
+     * Buffers a row, writing out a block whenever BLOCK_ROWS rows are buffered.
+     * @return false if a block failed to be written
+     */
+    bool append(const ResultRow &row);
+
+    /**
+     * Writes out any buffered rows as a new block followed by an updated footer,
+     * so everything appended so far is readable even if the process dies later.
+     * @return false if anything failed to be written
+     */
+    bool flush();
+
+protected:
+    FILE *file;
+
+    // End of the last complete footer, where the next block goes
+    uint64_t dataEnd;
+
+    // Whether the footer on disk is missing finder names or blocks
+    bool footerDirty;
+
+    std::vector<ResultBlockInfo> blocks;
+    std::vector<std::string> finderNames;
+
+    std::vector<uint64_t> mazeHash;
+    std::vector<double> simTime;
+    std::vector<double> wallTime;
+    std::vector<uint32_t> finder;
+    std::vector<uint32_t> steps;
+    std::vector<uint32_t> turns;
+    std::vector<uint32_t> exploredStep;
+    std::vector<uint8_t> status;
+
+    bool writeFooter();
+
+    // Not copyable, the file would be closed twice
+    ResultsWriter(const ResultsWriter &);
+    ResultsWriter &operator=(const ResultsWriter &);
+};
+
+/**
+ * Read only view of a store, memory mapped where the platform supports it.
+ */
+class ResultsReader {
+public:
+    ResultsReader();
+    ~ResultsReader();
+
+    /**
+     * @return false if the file could not be read or is not a valid store
+     */
+    bool open(const std::string &path);
+    void close();
+
+    inline size_t blockCount() const {
+        return blocks.size();
+    }
+
+    /**
+     * Fills in the column arrays of the given block.
+     */
+    void getBlock(size_t index, ResultColumns &columns) const;
+
+    inline const std::vector<std::string> &getFinderNames() const {
+        return finderNames;
+    }
+
+protected:
+    friend class ResultsWriter;
+
+    const unsigned char *data;
+    size_t size;
+
+    // Bytes up to the end of the last complete footer
+    size_t validSize;
+    bool mapped;
+
+    std::vector<ResultBlockInfo> blocks;
+    std::vector<std::string> finderNames;
+
+    // Not copyable, the mapping would be released twice
+    ResultsReader(const ResultsReader &);
+    ResultsReader &operator=(const ResultsReader &);
+};
+
+#endif
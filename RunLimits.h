@@ -0,0 +1,82 @@
+#ifndef RunLimits_h
+#define RunLimits_h
+
+#include <cstddef> // NULL
+
+class ExplorationOracle;
+
+/**
+ * Reason a call to Maze::start returned.
+ */
+enum RunResult {
+    RunFinished,        // PathFinder returned MouseMovement::Finish
+    RunCycleDetected,   // Mouse and PathFinder were caught repeating the same states forever
+    RunStepLimit,       // Run took more movements than allowed
+    RunTimeLimit,       // Run took more wall clock time than allowed
+    RunCrashed,         // PathFinder drove the mouse into a wall
+    RunExplored,        // Search was stopped because the mouse already knows an optimal path
+
+    RUN_RESULT_MAX
+};
+
+inline const char *runResultName(RunResult result) {
+    switch(result) {
+        case RunFinished:
+            return "finished";
+        case RunCycleDetected:
+            return "cycle";
+        case RunStepLimit:
+            return "step limit";
+        case RunTimeLimit:
+            return "time limit";
+        case RunCrashed:
+            return "crashed";
+        case RunExplored:
+            return "explored";
+        case RUN_RESULT_MAX:
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Limits used to end runs of misbehaving PathFinders early.
+ */
+struct RunLimits {
+    // Maximum number of movements before giving up, 0 for no limit
+    unsigned long maxSteps;
+
+    // Maximum wall clock seconds before giving up, 0 for no limit
+    double maxSeconds;
+
+    // Whether to stop PathFinders that provide a state hash as soon as the mouse
+    // and PathFinder come back to a state they were already in
+    bool detectCycles;
+
+    // Whether to also stop PathFinders without a state hash once the mouse has repeated
+    // the same loop of cells and headings for cycleConfirmSteps movements. Off by default,
+    // since a healthy PathFinder may Wait or replay a route for that long.
+    bool detectHashlessCycles;
+
+    // If the PathFinder does not provide a state hash, a loop in position and heading
+    // only counts as a cycle once it has repeated for this many movements
+    unsigned long cycleConfirmSteps;
+
+    // Longest loop that can be recognized without a state hash from the PathFinder
+    unsigned long cycleMaxPeriod;
+
+    // If set, fed the PathFinder's map before the first movement and after every movement
+    // to track when exploring was complete. Only works with PathFinders that implement saveMap.
+    ExplorationOracle *explorationOracle;
+
+    // Whether to end the run as soon as the explorationOracle reports exploring is complete
+    bool stopWhenExplored;
+
+    RunLimits()
+    : maxSteps(0), maxSeconds(0), detectCycles(true), detectHashlessCycles(false),
+      cycleConfirmSteps(16384), cycleMaxPeriod(4096),
+      explorationOracle(NULL), stopWhenExplored(false) {
+    }
+};
+
+#endif
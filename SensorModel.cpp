@@ -0,0 +1,54 @@
+#include "SensorModel.h"
+#include "Maze.h"
+#include "WallMap.h"
+
+SensorModel::SensorModel(unsigned frontRange, unsigned sideRange)
+: frontRange(frontRange < MazeDefinitions::MAZE_LEN ? frontRange : MazeDefinitions::MAZE_LEN),
+  sideRange(sideRange < MazeDefinitions::MAZE_LEN ? sideRange : MazeDefinitions::MAZE_LEN) {
+}
+
+void SensorModel::sense(const Maze &maze, SensorReading &reading) const {
+    readRay(maze, maze.mouseX, maze.mouseY, maze.heading, frontRange, reading.front);
+    readRay(maze, maze.mouseX, maze.mouseY, counterClockwise(maze.heading), sideRange, reading.left);
+    readRay(maze, maze.mouseX, maze.mouseY, clockwise(maze.heading), sideRange, reading.right);
+}
+
+void SensorModel::record(const SensorReading &reading, unsigned x, unsigned y, Dir heading, WallMap &map) {
+    recordRay(reading.front, x, y, heading, map);
+    recordRay(reading.left, x, y, counterClockwise(heading), map);
+    recordRay(reading.right, x, y, clockwise(heading), map);
+}
+
+void SensorModel::readRay(const Maze &maze, unsigned x, unsigned y, Dir d, unsigned range, RayReading &ray) {
+    ray.openCells = maze.openDistance(x, y, d, range);
+
+    // Every open wall was seen, plus the closed one that stopped the ray if it was in range
+    const unsigned seen = (ray.openCells < range) ? ray.openCells + 1 : ray.openCells;
+
+    ray.open = (uint16_t)((1u << ray.openCells) - 1);
+    ray.visible = (uint16_t)((1u << seen) - 1);
+}
+
+void SensorModel::recordRay(const RayReading &ray, unsigned x, unsigned y, Dir d, WallMap &map) {
+    for(unsigned i = 0; i < MazeDefinitions::MAZE_LEN && (ray.visible >> i) != 0; i++) {
+        map.setWall(x, y, d, (ray.open & (1u << i)) != 0);
+
+        switch(d) {
+            case NORTH:
+                y++;
+                break;
+            case SOUTH:
+                y--;
+                break;
+            case EAST:
+                x++;
+                break;
+            case WEST:
+                x--;
+                break;
+            case INVALID:
+            default:
+                return;
+        }
+    }
+}
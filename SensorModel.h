@@ -0,0 +1,72 @@
+#ifndef SensorModel_h
+#define SensorModel_h
+
+#include <stdint.h> // uint16_t
+
+#include "Dir.h"
+#include "MazeDefinitions.h"
+
+class Maze;
+class WallMap;
+
+/**
+ * What a single range sensor sees along a straight line out of the mouse's cell.
+ * Wall 0 is the wall on that side of the mouse's own cell, wall 1 the one a cell further, and so on.
+ */
+struct RayReading {
+    unsigned openCells;     // Open walls in a row before the first closed one or the end of the range
+    uint16_t visible;       // Bit i is set if wall i was seen
+    uint16_t open;          // Bit i is set if wall i was seen to be open
+};
+
+/**
+ * Readings of all sensors of a mouse for one step.
+ */
+struct SensorReading {
+    RayReading front;
+    RayReading left;
+    RayReading right;
+};
+
+/**
+ * Range sensors that see several cells ahead and to the sides of the mouse.
+ *
+ * Each sensor reports walls along its ray until the first closed wall or the end of its range.
+ * A range of 1 matches Maze::wallInFront, wallOnLeft and wallOnRight.
+ * The sensors belong to the Maze, so every PathFinder run on it gets the same ones,
+ * and PathFinders read them through Maze::sense from the mouse's own cell only.
+ */
+class SensorModel {
+public:
+    SensorModel(unsigned frontRange = MazeDefinitions::MAZE_LEN, unsigned sideRange = 1);
+
+    /**
+     * Records every wall seen in a reading taken from the given cell and heading into a map.
+     */
+    static void record(const SensorReading &reading, unsigned x, unsigned y, Dir heading, WallMap &map);
+
+    inline unsigned getFrontRange() const {
+        return frontRange;
+    }
+
+    inline unsigned getSideRange() const {
+        return sideRange;
+    }
+
+private:
+    unsigned frontRange;
+    unsigned sideRange;
+
+    // Only the Maze senses, from its own mouse
+    friend class Maze;
+
+    /**
+     * Senses walls from the maze's mouse, in its current cell and heading.
+     */
+    void sense(const Maze &maze, SensorReading &reading) const;
+
+    static void readRay(const Maze &maze, unsigned x, unsigned y, Dir d, unsigned range, RayReading &ray);
+    static void recordRay(const RayReading &ray, unsigned x, unsigned y, Dir d, WallMap &map);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "Session.h"
+
+Session::Session(MazeDefinitions::MazeEncodingName name, PathFinder *pathFinder, const MotionProfile &motionProfile)
+: maze(name, pathFinder), pathFinder(pathFinder), motionProfile(motionProfile), totalTime(0) {
+}
+
+double Session::run(unsigned count, const RunLimits &limits) {
+    if(!pathFinder) {
+        return totalTime;
+    }
+
+    for(unsigned i = 0; i < count; i++) {
+        runs.push_back(SessionRun());
+        SessionRun &current = runs.back();
+
+        maze.resetMouse();
+        pathFinder->beginRun((unsigned)runs.size() - 1);
+
+        // Hand back what was learned so far, restored from its compact form
+        WallMap learned;
+        if(!learnedMap.empty() && learned.deserialize(learnedMap.data(), learnedMap.size())) {
+            pathFinder->loadMap(learned);
+        }
+
+        maze.setMovementLog(&current.movements);
+        current.result = maze.start(limits);
+        maze.setMovementLog(NULL);
+
+        current.time = motionProfile.time(current.movements);
+        totalTime += current.time;
+
+        if(pathFinder->saveMap(map)) {
+            learnedMap.clear();
+            map.serialize(learnedMap);
+        }
+
+        if(current.result == RunCrashed) {
+            break;
+        }
+    }
+
+    return totalTime;
+}
+
+bool Session::loadMap(const std::string &path) {
+    if(!map.load(path)) {
+        return false;
+    }
+
+    learnedMap.clear();
+    map.serialize(learnedMap);
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef Session_h
+#define Session_h
+
+#include <vector>
+
+#include "Maze.h"
+#include "MotionProfile.h"
+#include "WallMap.h"
+
+/**
+ * Outcome of a single run within a Session.
+ */
+struct SessionRun {
+    RunResult result;
+    std::vector<MouseMovement> movements;
+    double time;
+};
+
+/**
+ * Drives a sequence of runs through the same maze, like the several runs of a contest.
+ *
+ * The mouse is put back at the start before every run, and the map the PathFinder
+ * learned is collected after each run and handed back to it before the next, so that
+ * later runs can skip exploring. The map can also be loaded from and saved to disk
+ * to carry it over to a later process.
+ */
+class Session {
+public:
+    Session(MazeDefinitions::MazeEncodingName name, PathFinder *pathFinder,
+            const MotionProfile &motionProfile = MotionProfile());
+
+    /**
+     * Performs the given number of runs, stopping early if the mouse crashes.
+     * @return total simulated time of all runs performed so far, in seconds
+     */
+    double run(unsigned runs, const RunLimits &limits = RunLimits());
+
+    inline const std::vector<SessionRun> &getRuns() const {
+        return runs;
+    }
+
+    inline double getTotalTime() const {
+        return totalTime;
+    }
+
+    /**
+     * @return the latest map produced by the PathFinder, or the loaded one if there is none yet
+     */
+    inline const WallMap &getMap() const {
+        return map;
+    }
+
+    /**
+     * Loads a map from disk, to be handed to the PathFinder before the next run.
+     * @return false if the file could not be read
+     */
+    bool loadMap(const std::string &path);
+
+    /**
+     * @return false if the file could not be written
+     */
+    inline bool saveMap(const std::string &path) const {
+        return map.save(path);
+    }
+
+    inline Maze &getMaze() {
+        return maze;
+    }
+
+protected:
+    Maze maze;
+    PathFinder *pathFinder;
+    const MotionProfile motionProfile;
+
+    std::vector<SessionRun> runs;
+    double totalTime;
+    WallMap map;
+
+    // The same map in its serialized form, which is what is kept between runs
+    std::vector<unsigned char> learnedMap;
+};
+
+#endif
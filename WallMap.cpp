@@ -0,0 +1,74 @@
+#include <cstdio>
+
+#include "WallMap.h"
+
+namespace {
+    const unsigned char MAGIC[4] = { 'M', 'M', 'W', 'M' };
+
+    void putPlane(std::vector<unsigned char> &out, const BitVector256 &plane) {
+        for(unsigned x = 0; x < BitVector256::VECTOR_SIZE; x++) {
+            const uint16_t bits = plane.getBits(x);
+            out.push_back((unsigned char)(bits & 0xFF));
+            out.push_back((unsigned char)(bits >> 8));
+        }
+    }
+
+    const unsigned char *getPlane(const unsigned char *in, BitVector256 &plane) {
+        for(unsigned x = 0; x < BitVector256::VECTOR_SIZE; x++) {
+            plane.setBits(x, (uint16_t)(in[0] | (in[1] << 8)));
+            in += 2;
+        }
+
+        return in;
+    }
+}
+
+void WallMap::serialize(std::vector<unsigned char> &out) const {
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    putPlane(out, knownNS);
+    putPlane(out, knownEW);
+    putPlane(out, openNS);
+    putPlane(out, openEW);
+}
+
+bool WallMap::deserialize(const unsigned char *data, size_t size) {
+    if(size != SERIALIZED_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+
+    const unsigned char *in = data + sizeof(MAGIC);
+    in = getPlane(in, knownNS);
+    in = getPlane(in, knownEW);
+    in = getPlane(in, openNS);
+    getPlane(in, openEW);
+
+    return true;
+}
+
+bool WallMap::save(const std::string &path) const {
+    std::vector<unsigned char> data;
+    serialize(data);
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if(!file) {
+        return false;
+    }
+
+    const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return (fclose(file) == 0) && written;
+}
+
+bool WallMap::load(const std::string &path) {
+    unsigned char data[SERIALIZED_SIZE + 1];
+
+    FILE *file = fopen(path.c_str(), "rb");
+    if(!file) {
+        return false;
+    }
+
+    // Ask for one byte more than needed to catch files that are too long
+    const size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+
+    return deserialize(data, size);
+}
@@ -0,0 +1,149 @@
+#ifndef WallMap_h
+#define WallMap_h
+
+#include <string>
+#include <vector>
+
+#include "BitVector256.h"
+#include "Dir.h"
+
+/**
+ * Walls a mouse has sensed so far, used to carry what a PathFinder learned between runs.
+ *
+ * Planes use the same layout as Maze: bit (x, y) of the NS planes is the wall between
+ * cells (x, y-1) and (x, y), and bit (x, y) of the EW planes is the wall between
+ * cells (x-1, y) and (x, y). A wall is only open if it is both known and open.
+ * The outer boundary is always known to be closed.
+ */
+class WallMap {
+public:
+    // Magic number followed by the four planes
+    static const size_t SERIALIZED_SIZE = 4 + 4 * 2 * BitVector256::VECTOR_SIZE;
+
+    WallMap() {
+        clear();
+    }
+
+    inline void clear() {
+        knownNS.clearAll();
+        knownEW.clearAll();
+        openNS.clearAll();
+        openEW.clearAll();
+    }
+
+    /**
+     * Records the wall on side d of cell (x, y) as sensed.
+     */
+    inline void setWall(unsigned x, unsigned y, Dir d, bool open) {
+        unsigned wx, wy;
+        bool ns;
+
+        if(!locate(x, y, d, wx, wy, ns)) {
+            return;
+        }
+
+        (ns ? knownNS : knownEW).set(wx, wy);
+
+        if(open) {
+            (ns ? openNS : openEW).set(wx, wy);
+        } else {
+            (ns ? openNS : openEW).clear(wx, wy);
+        }
+    }
+
+    inline bool isKnown(unsigned x, unsigned y, Dir d) const {
+        unsigned wx, wy;
+        bool ns;
+
+        if(!locate(x, y, d, wx, wy, ns)) {
+            return true;
+        }
+
+        return (ns ? knownNS : knownEW).get(wx, wy);
+    }
+
+    inline bool isOpen(unsigned x, unsigned y, Dir d) const {
+        unsigned wx, wy;
+        bool ns;
+
+        if(!locate(x, y, d, wx, wy, ns)) {
+            return false;
+        }
+
+        return (ns ? openNS : openEW).get(wx, wy);
+    }
+
+    inline const BitVector256 &getKnownNS() const { return knownNS; }
+    inline const BitVector256 &getKnownEW() const { return knownEW; }
+    inline const BitVector256 &getOpenNS() const { return openNS; }
+    inline const BitVector256 &getOpenEW() const { return openEW; }
+
+    inline bool operator==(const WallMap &other) const {
+        return knownNS == other.knownNS && knownEW == other.knownEW &&
+               openNS == other.openNS && openEW == other.openEW;
+    }
+
+    inline bool operator!=(const WallMap &other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * Appends the map to out in a fixed SERIALIZED_SIZE byte form
+     * that does not depend on the host's byte order.
+     */
+    void serialize(std::vector<unsigned char> &out) const;
+
+    /**
+     * @return false if the data is not a serialized map, in which case the map is left untouched
+     */
+    bool deserialize(const unsigned char *data, size_t size);
+
+    /**
+     * @return false if the file could not be written
+     */
+    bool save(const std::string &path) const;
+
+    /**
+     * @return false if the file could not be read or does not hold a map
+     */
+    bool load(const std::string &path);
+
+protected:
+    BitVector256 knownNS;
+    BitVector256 knownEW;
+    BitVector256 openNS;
+    BitVector256 openEW;
+
+    /**
+     * Finds the bit that holds the wall on side d of cell (x, y).
+     * @param ns: set to true if the wall is in the NS planes, false for the EW planes
+     * @return false if the wall is part of the outer boundary
+     */
+    static inline bool locate(unsigned x, unsigned y, Dir d, unsigned &wx, unsigned &wy, bool &ns) {
+        const unsigned len = BitVector256::VECTOR_SIZE;
+        wx = x;
+        wy = y;
+
+        switch(d) {
+            case NORTH:
+                wy = y + 1;
+                ns = true;
+                return x < len && wy < len;
+            case SOUTH:
+                ns = true;
+                return x < len && y > 0 && y < len;
+            case EAST:
+                wx = x + 1;
+                ns = false;
+                return y < len && wx < len;
+            case WEST:
+                ns = false;
+                return y < len && x > 0 && x < len;
+            case INVALID:
+            default:
+                return false;
+        }
+    }
+};
+
+#endif
@@ -1,9 +1,21 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <cstdlib>  // atoi
+#include <vector>
 
+#include "ExplorationOracle.h"
 #include "Maze.h"
+#include "MazeCorpus.h"
 #include "MazeDefinitions.h"
+#include "MotionProfile.h"
 #include "PathFinder.h"
+#include "ResultsStore.h"
+#include "Session.h"
+#include "WallMap.h"
 
 /**
  * Demo of a PathFinder implementation.
@@ -13,14 +25,26 @@
  */
 class LeftWallFollower : public PathFinder {
 public:
-    LeftWallFollower(bool shouldPause = false) : pause(shouldPause) {
+    LeftWallFollower(bool shouldPause = false, bool shouldPrint = true) : pause(shouldPause), verbose(shouldPrint) {
+        beginRun(0);
+    }
+
+    void beginRun(unsigned run) {
+        (void)run;
         shouldGoForward = false;
         visitedStart = false;
+        heading = NORTH;
     }
 
     MouseMovement nextMovement(unsigned x, unsigned y, const Maze &maze) {
         const bool frontWall = maze.wallInFront();
         const bool leftWall  = maze.wallOnLeft();
+        const bool rightWall = maze.wallOnRight();
+
+        // Remember what we have seen, the demo does not use it but a session keeps it between runs
+        map.setWall(x, y, heading, !frontWall);
+        map.setWall(x, y, counterClockwise(heading), !leftWall);
+        map.setWall(x, y, clockwise(heading), !rightWall);
 
         // Pause at each cell if the user requests it.
         // It allows for better viewing on command line.
@@ -30,12 +54,16 @@ public:
             std::cin.clear();
         }
 
-        std::cout << maze.draw(5) << std::endl << std::endl;
+        if(verbose) {
+            std::cout << maze.draw(5) << std::endl << std::endl;
+        }
 
         // If we somehow miraculously hit the center
         // of the maze, just terminate and celebrate!
         if(isAtCenter(x, y)) {
-            std::cout << "Found center! Good enough for the demo, won't try to get back." << std::endl;
+            if(verbose) {
+                std::cout << "Found center! Good enough for the demo, won't try to get back." << std::endl;
+            }
             return Finish;
         }
 
@@ -43,7 +71,9 @@ public:
         // we couldn't find the center and never will...
         if(x == 0 && y == 0) {
             if(visitedStart) {
-                std::cout << "Unable to find center, giving up." << std::endl;
+                if(verbose) {
+                    std::cout << "Unable to find center, giving up." << std::endl;
+                }
                 return Finish;
             } else {
                 visitedStart = true;
@@ -67,20 +97,39 @@ public:
         // we should try going to the right!
         if(frontWall && leftWall) {
             shouldGoForward = false;
+            heading = clockwise(heading);
             return TurnClockwise;
         }
 
         // Lastly, if there is no left wall we should take that path!
         if(!leftWall) {
             shouldGoForward = true;
+            heading = counterClockwise(heading);
             return TurnCounterClockwise;
         }
 
         // If we get stuck somehow, just terminate.
-        std::cout << "Got stuck..." << std::endl;
+        if(verbose) {
+            std::cout << "Got stuck..." << std::endl;
+        }
         return Finish;
     }
 
+    bool getStateHash(uint64_t &hash) {
+        hash = (shouldGoForward ? 1 : 0) | (visitedStart ? 2 : 0);
+        return true;
+    }
+
+    bool saveMap(WallMap &out) {
+        out = map;
+        return true;
+    }
+
+    bool loadMap(const WallMap &in) {
+        map = in;
+        return true;
+    }
+
 protected:
     // Helps us determine that we should go forward if we have just turned left.
     bool shouldGoForward;
@@ -88,10 +137,19 @@ protected:
     // Helps us determine if we've made a loop around the maze without finding the center.
     bool visitedStart;
 
+    // Which way we are facing, tracked from the turns we make.
+    Dir heading;
+
+    // Every wall we have sensed so far.
+    WallMap map;
+
     // Indicates we should pause before moving to next cell.
     // Useful for command line usage.
     const bool pause;
 
+    // Indicates the maze and progress messages should be printed at each step.
+    const bool verbose;
+
     bool isAtCenter(unsigned x, unsigned y) const {
         unsigned midpoint = MazeDefinitions::MAZE_LEN / 2;
 
@@ -106,9 +164,91 @@ protected:
     }
 };
 
+/**
+ * Runs the demo on mazes claimed one at a time from nextMaze until none are left,
+ * appending a row per run to the writer if one is given.
+ * Each run also reports the step at which the mouse first knew an optimal path,
+ * and stops there if stopWhenExplored is set.
+ * Several of these can run at once, as long as each has its own writer.
+ */
+static void runMazes(const std::vector<MazeDefinitions::MazeEncodingName> &mazeNames,
+                     std::atomic<size_t> &nextMaze, bool pause, bool verbose, bool stopWhenExplored,
+                     const MotionProfile &motionProfile, ResultsWriter *writer) {
+    typedef std::chrono::steady_clock Clock;
+    const uint32_t finderId = writer ? writer->finderId("LeftWallFollower") : 0;
+
+    for(size_t i = nextMaze++; i < mazeNames.size(); i = nextMaze++) {
+        LeftWallFollower leftWallFollower(pause, verbose);
+        Maze maze(mazeNames[i], &leftWallFollower);
+        std::vector<MouseMovement> movements;
+        maze.setMovementLog(&movements);
+
+        const uint64_t mazeHash = maze.canonicalHash();
+
+        if(verbose) {
+            std::cout << maze.draw(5) << std::endl << std::endl;
+        }
+
+        const Clock::time_point startTime = Clock::now();
+        ExplorationOracle explorationOracle(maze);
+        RunLimits limits;
+        limits.explorationOracle = &explorationOracle;
+        limits.stopWhenExplored = stopWhenExplored;
+
+        const RunResult result = maze.start(limits);
+        const std::chrono::duration<double> wallTime = Clock::now() - startTime;
+        const double simTime = motionProfile.time(movements);
+
+        // Build the whole line first so lines from different workers do not interleave
+        std::ostringstream summary;
+        summary << "Maze " << mazeNames[i] << " (hash " << std::hex << mazeHash << std::dec << "): "
+                << runResultName(result) << ", " << movements.size() << " movements, simulated run time "
+                << simTime << "s, ";
+
+        if(explorationOracle.getCompleteStep() != ExplorationOracle::NOT_COMPLETE) {
+            summary << "optimal path known after " << explorationOracle.getCompleteStep() << " movements" << std::endl;
+        } else {
+            summary << "optimal path not known" << std::endl;
+        }
+
+        std::cout << summary.str() << std::flush;
+
+        if(writer) {
+            ResultRow row;
+            row.mazeHash = mazeHash;
+            row.simTime = simTime;
+            row.wallTime = wallTime.count();
+            row.finder = finderId;
+            row.steps = (uint32_t)movements.size();
+            row.status = (uint8_t)result;
+
+            if(explorationOracle.getCompleteStep() != ExplorationOracle::NOT_COMPLETE) {
+                row.exploredStep = (uint32_t)explorationOracle.getCompleteStep();
+            }
+
+            for(size_t m = 0; m < movements.size(); m++) {
+                if(movements[m] == TurnClockwise || movements[m] == TurnCounterClockwise || movements[m] == TurnAround) {
+                    row.turns++;
+                }
+            }
+
+            if(!writer->append(row)) {
+                std::cerr << "Failed to write results" << std::endl;
+            }
+        }
+    }
+}
+
 int main(int argc, char * argv[]) {
     MazeDefinitions::MazeEncodingName mazeName = MazeDefinitions::MAZE_CAMM_2012;
     bool pause = false;
+    bool runAll = false;
+    bool quiet = false;
+    bool stopWhenExplored = false;
+    unsigned jobs = 1;
+    std::string resultsPath;
+    unsigned sessionRuns = 0;
+    std::string mapPath;
 
     // Since Windows does not support getopt directly, we will
     // have to parse the command line arguments ourselves.
@@ -122,17 +262,119 @@ int main(int argc, char * argv[]) {
             }
         } else if(strcmp(argv[i], "-p") == 0) {
             pause = true;
+        } else if(strcmp(argv[i], "-a") == 0) {
+            runAll = true;
+        } else if(strcmp(argv[i], "-e") == 0) {
+            stopWhenExplored = true;
+        } else if(strcmp(argv[i], "-q") == 0) {
+            quiet = true;
+        } else if(strcmp(argv[i], "-j") == 0 && i+1 < argc) {
+            int jobsOption = atoi(argv[++i]);
+            jobs = (jobsOption > 0) ? (unsigned)jobsOption : 1;
+        } else if(strcmp(argv[i], "-o") == 0 && i+1 < argc) {
+            resultsPath = argv[++i];
+        } else if(strcmp(argv[i], "-s") == 0 && i+1 < argc) {
+            int runsOption = atoi(argv[++i]);
+            sessionRuns = (runsOption > 0) ? (unsigned)runsOption : 1;
+        } else if(strcmp(argv[i], "-M") == 0 && i+1 < argc) {
+            mapPath = argv[++i];
         } else {
-            std::cout << "Usage: " << argv[0] << " [-m N] [-p]" << std::endl;
+            std::cout << "Usage: " << argv[0] << " [-m N | -a] [-p] [-e] [-q] [-j N] [-o FILE] [-s N [-M FILE]]" << std::endl;
             std::cout << "\t-m N will load the maze corresponding to N, or 0 if invalid N or missing option" << std::endl;
+            std::cout << "\t-a will run every distinct built in maze, skipping rotated or mirrored duplicates" << std::endl;
             std::cout << "\t-p will wait for a newline in between cell traversals" << std::endl;
+            std::cout << "\t-e will stop each run as soon as the mouse knows an optimal path" << std::endl;
+            std::cout << "\t-q will only print a summary line per run" << std::endl;
+            std::cout << "\t-j N will run N mazes at a time, implies -q" << std::endl;
+            std::cout << "\t-o FILE will append results to FILE, or FILE.0 to FILE.N-1 if more than one job is used" << std::endl;
+            std::cout << "\t-s N will run a session of N runs on the maze, keeping what the mouse learned between runs" << std::endl;
+            std::cout << "\t-M FILE will load the learned map from FILE before a session, if it exists, and save it after" << std::endl;
             return -1;
         }
     }
 
-    LeftWallFollower leftWallFollower(pause);
-    Maze maze(mazeName, &leftWallFollower);
-    std::cout << maze.draw(5) << std::endl << std::endl;
+    if(sessionRuns > 0) {
+        LeftWallFollower leftWallFollower(pause, !quiet);
+        Session session(mazeName, &leftWallFollower);
+
+        if(!mapPath.empty() && std::ifstream(mapPath.c_str(), std::ios::binary).good()) {
+            // Never overwrite a file that holds something other than a map
+            if(!session.loadMap(mapPath)) {
+                std::cerr << mapPath << " is not a valid map file" << std::endl;
+                return -1;
+            }
+
+            std::cout << "Loaded map from " << mapPath << std::endl;
+        }
+
+        session.run(sessionRuns);
+
+        const std::vector<SessionRun> &runs = session.getRuns();
+        for(size_t i = 0; i < runs.size(); i++) {
+            std::cout << "Run " << i << ": " << runResultName(runs[i].result) << ", "
+                      << runs[i].movements.size() << " movements, " << runs[i].time << "s" << std::endl;
+        }
+
+        std::cout << "Session time " << session.getTotalTime() << "s" << std::endl;
+
+        if(!mapPath.empty() && !session.saveMap(mapPath)) {
+            std::cerr << "Unable to save map to " << mapPath << std::endl;
+            return -1;
+        }
+
+        return 0;
+    }
+
+    std::vector<MazeDefinitions::MazeEncodingName> mazeNames(1, mazeName);
+
+    if(runAll) {
+        MazeCorpus corpus;
+        const unsigned duplicates = corpus.addAll();
+        mazeNames = corpus.mazes();
+
+        std::cout << "Running " << mazeNames.size() << " distinct mazes, skipped "
+                  << duplicates << " duplicates" << std::endl;
+    }
 
-    maze.start();
+    const MotionProfile motionProfile;
+    std::vector<ResultsWriter> writers(resultsPath.empty() ? 0 : jobs);
+
+    for(unsigned j = 0; j < writers.size(); j++) {
+        std::ostringstream path;
+        path << resultsPath;
+
+        if(jobs > 1) {
+            path << "." << j;
+        }
+
+        if(!writers[j].open(path.str())) {
+            std::cerr << "Unable to open results file " << path.str() << std::endl;
+            return -1;
+        }
+    }
+
+    std::atomic<size_t> nextMaze(0);
+    const bool verbose = !quiet && jobs == 1;
+
+    if(jobs == 1) {
+        runMazes(mazeNames, nextMaze, pause, verbose, stopWhenExplored, motionProfile, writers.empty() ? NULL : &writers[0]);
+    } else {
+        std::vector<std::thread> workers;
+
+        for(unsigned j = 0; j < jobs; j++) {
+            workers.push_back(std::thread(runMazes, std::cref(mazeNames), std::ref(nextMaze), pause, verbose, stopWhenExplored,
+                                          std::cref(motionProfile), writers.empty() ? NULL : &writers[j]));
+        }
+
+        for(unsigned j = 0; j < jobs; j++) {
+            workers[j].join();
+        }
+    }
+
+    for(unsigned j = 0; j < writers.size(); j++) {
+        if(!writers[j].close()) {
+            std::cerr << "Failed to write results" << std::endl;
+            return -1;
+        }
+    }
 }
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <cstdlib>  // rand
+#include <vector>
+
+#include "../Maze.h"
+#include "../MazeDefinitions.h"
+#include "../PathFinder.h"
+
+/**
+ * Regression test for cycle detection in Maze::start.
+ *
+ * Drives PathFinders that replay a fixed script of movements forever and checks that
+ * every one of them is stopped when hashless cycle detection is enabled, and that
+ * PathFinders which merely repeat themselves for a while before finishing are left
+ * alone, in particular by the default limits.
+ */
+
+class ScriptedFinder : public PathFinder {
+public:
+    ScriptedFinder(const std::vector<MouseMovement> &script, unsigned long finishAfter = 0, bool hashed = false)
+    : script(script), finishAfter(finishAfter), hashed(hashed), steps(0) {
+    }
+
+    MouseMovement nextMovement(unsigned x, unsigned y, const Maze &maze) {
+        (void)x;
+        (void)y;
+
+        // Avoid crashing so the script keeps running for as long as possible
+        MouseMovement next = script[steps % script.size()];
+        if(next == MoveForward && maze.wallInFront()) {
+            next = Wait;
+        }
+
+        steps++;
+        if(finishAfter != 0 && steps > finishAfter) {
+            return Finish;
+        }
+
+        return next;
+    }
+
+    bool getStateHash(uint64_t &hash) {
+        // Only the position in the script matters once the run is looping
+        hash = steps % script.size();
+        return hashed && finishAfter == 0;
+    }
+
+protected:
+    const std::vector<MouseMovement> script;
+    const unsigned long finishAfter;
+    const bool hashed;
+    unsigned long steps;
+};
+
+static const char *movementName(MouseMovement movement) {
+    switch(movement) {
+        case MoveForward:
+            return "MoveForward";
+        case MoveBackward:
+            return "MoveBackward";
+        case TurnClockwise:
+            return "TurnClockwise";
+        case TurnCounterClockwise:
+            return "TurnCounterClockwise";
+        case TurnAround:
+            return "TurnAround";
+        case Wait:
+            return "Wait";
+        case Finish:
+        default:
+            return "Finish";
+    }
+}
+
+static bool expectResult(const std::vector<MouseMovement> &script, unsigned long finishAfter, bool hashed,
+                         MazeDefinitions::MazeEncodingName mazeName, const RunLimits &limits, RunResult expected) {
+    ScriptedFinder finder(script, finishAfter, hashed);
+    Maze maze(mazeName, &finder);
+
+    const RunResult result = maze.start(limits);
+    if(result == expected) {
+        return true;
+    }
+
+    std::cout << "FAIL: maze " << mazeName << " script [";
+    for(size_t i = 0; i < script.size(); i++) {
+        std::cout << (i ? ", " : "") << movementName(script[i]);
+    }
+    std::cout << "] ended with " << runResultName(result) << ", expected " << runResultName(expected) << std::endl;
+
+    return false;
+}
+
+int main() {
+    // MoveBackward is left out since it can not be guarded against crashing
+    const MouseMovement movements[] = { MoveForward, TurnClockwise, TurnCounterClockwise, TurnAround, Wait };
+    const unsigned movementCount = sizeof(movements) / sizeof(*movements);
+    unsigned failures = 0;
+
+    RunLimits hashless;
+    hashless.maxSteps = 200000;
+    hashless.detectHashlessCycles = true;
+    hashless.cycleConfirmSteps = 1024;
+
+    RunLimits defaults;
+    defaults.maxSteps = 200000;
+
+    srand(27);
+
+    for(unsigned i = 0; i < 3000; i++) {
+        std::vector<MouseMovement> script(2 + rand() % 10);
+        for(size_t m = 0; m < script.size(); m++) {
+            script[m] = movements[rand() % movementCount];
+        }
+
+        const MazeDefinitions::MazeEncodingName mazeName =
+            (MazeDefinitions::MazeEncodingName)(rand() % MazeDefinitions::MAZE_NAME_MAX);
+
+        if(!expectResult(script, 0, false, mazeName, hashless, RunCycleDetected)) {
+            failures++;
+        }
+
+        // Finders with a hash are caught by the default limits
+        if(i % 10 == 0 && !expectResult(script, 0, true, mazeName, defaults, RunCycleDetected)) {
+            failures++;
+        }
+    }
+
+    // Scripts that would loop, but finish before repeating for cycleConfirmSteps movements
+    std::vector<MouseMovement> waiting(1, Wait);
+    std::vector<MouseMovement> spinning;
+    spinning.push_back(TurnClockwise);
+    spinning.push_back(TurnAround);
+
+    if(!expectResult(waiting, 500, false, MazeDefinitions::MAZE_CAMM_2012, hashless, RunFinished)) {
+        failures++;
+    }
+
+    if(!expectResult(spinning, 500, false, MazeDefinitions::MAZE_CAMM_2012, hashless, RunFinished)) {
+        failures++;
+    }
+
+    // A finder without a hash that Waits or spins for a long time is left alone by default
+    if(!expectResult(waiting, 50000, false, MazeDefinitions::MAZE_CAMM_2012, defaults, RunFinished)) {
+        failures++;
+    }
+
+    if(!expectResult(spinning, 50000, false, MazeDefinitions::MAZE_CAMM_2012, defaults, RunFinished)) {
+        failures++;
+    }
+
+    // and is still stopped when hashless detection is enabled with its default window
+    RunLimits hashlessDefaultWindow;
+    hashlessDefaultWindow.maxSteps = 200000;
+    hashlessDefaultWindow.detectHashlessCycles = true;
+
+    if(!expectResult(spinning, 0, false, MazeDefinitions::MAZE_CAMM_2012, hashlessDefaultWindow, RunCycleDetected)) {
+        failures++;
+    }
+
+    std::cout << (failures ? "FAILED: " : "Passed: ") << failures << " failures" << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <cstdlib>  // rand
+
+#include "../BitVector256.h"
+#include "../Dir.h"
+#include "../Maze.h"
+#include "../MazeDefinitions.h"
+#include "../MazeSymmetry.h"
+
+/**
+ * Regression test for the bit kernels behind canonical maze hashing.
+ *
+ * Checks every transform of MazeSymmetry::apply against moving each open wall of every
+ * built in maze cell by cell, BitVector256::transpose against a bit by bit transpose,
+ * and that all 8 variants of a maze canonicalize to the same planes and hash.
+ */
+
+// Exposes the wall planes of a maze to the test
+class MazeWalls : public Maze {
+public:
+    MazeWalls(MazeDefinitions::MazeEncodingName name) : Maze(name, NULL) {
+    }
+
+    inline const BitVector256 &getWallNS() const { return wallNS; }
+    inline const BitVector256 &getWallEW() const { return wallEW; }
+
+    using Maze::isOpen;
+};
+
+static const Dir directions[] = { NORTH, SOUTH, EAST, WEST };
+
+static void setOpen(unsigned x, unsigned y, Dir d, BitVector256 &wallNS, BitVector256 &wallEW) {
+    switch(d) {
+        case NORTH:
+            return wallNS.set(x, y+1);
+        case SOUTH:
+            return wallNS.set(x, y);
+        case EAST:
+            return wallEW.set(x+1, y);
+        case WEST:
+            return wallEW.set(x, y);
+        case INVALID:
+        default:
+            return;
+    }
+}
+
+/**
+ * Moves a cell and a direction out of it the way the transform moves the whole maze.
+ */
+static void transformCell(unsigned transform, unsigned &x, unsigned &y, Dir &d) {
+    const unsigned last = MazeDefinitions::MAZE_LEN - 1;
+
+    if(transform & MazeSymmetry::FLIP_X) {
+        x = last - x;
+        d = (d == EAST || d == WEST) ? opposite(d) : d;
+    }
+
+    if(transform & MazeSymmetry::FLIP_Y) {
+        y = last - y;
+        d = (d == NORTH || d == SOUTH) ? opposite(d) : d;
+    }
+
+    if(transform & MazeSymmetry::TRANSPOSE) {
+        const unsigned tmp = x;
+        x = y;
+        y = tmp;
+
+        switch(d) {
+            case NORTH:
+                d = EAST;
+                break;
+            case EAST:
+                d = NORTH;
+                break;
+            case SOUTH:
+                d = WEST;
+                break;
+            case WEST:
+                d = SOUTH;
+                break;
+            case INVALID:
+            default:
+                break;
+        }
+    }
+}
+
+static unsigned testApply(const MazeWalls &maze, MazeDefinitions::MazeEncodingName name) {
+    unsigned failures = 0;
+
+    for(unsigned transform = MazeSymmetry::IDENTITY; transform < MazeSymmetry::TRANSFORM_MAX; transform++) {
+        BitVector256 expectedNS, expectedEW;
+
+        for(unsigned x = 0; x < MazeDefinitions::MAZE_LEN; x++) {
+            for(unsigned y = 0; y < MazeDefinitions::MAZE_LEN; y++) {
+                for(unsigned i = 0; i < sizeof(directions) / sizeof(*directions); i++) {
+                    if(!maze.isOpen(x, y, directions[i])) {
+                        continue;
+                    }
+
+                    unsigned tx = x, ty = y;
+                    Dir td = directions[i];
+                    transformCell(transform, tx, ty, td);
+                    setOpen(tx, ty, td, expectedNS, expectedEW);
+                }
+            }
+        }
+
+        BitVector256 ns = maze.getWallNS();
+        BitVector256 ew = maze.getWallEW();
+        MazeSymmetry::apply(transform, ns, ew);
+
+        if(ns != expectedNS || ew != expectedEW) {
+            std::cout << "FAIL: maze " << name << " transform " << transform
+                      << " does not match moving each wall" << std::endl;
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+static unsigned testCanonicalize(const MazeWalls &maze, MazeDefinitions::MazeEncodingName name) {
+    unsigned failures = 0;
+
+    BitVector256 canonicalNS = maze.getWallNS();
+    BitVector256 canonicalEW = maze.getWallEW();
+    const unsigned applied = MazeSymmetry::canonicalize(canonicalNS, canonicalEW);
+
+    BitVector256 ns = maze.getWallNS();
+    BitVector256 ew = maze.getWallEW();
+    MazeSymmetry::apply(applied, ns, ew);
+
+    if(ns != canonicalNS || ew != canonicalEW) {
+        std::cout << "FAIL: maze " << name << " canonicalize returned the wrong transform" << std::endl;
+        failures++;
+    }
+
+    for(unsigned transform = MazeSymmetry::IDENTITY; transform < MazeSymmetry::TRANSFORM_MAX; transform++) {
+        ns = maze.getWallNS();
+        ew = maze.getWallEW();
+        MazeSymmetry::apply(transform, ns, ew);
+        MazeSymmetry::canonicalize(ns, ew);
+
+        if(ns != canonicalNS || ew != canonicalEW) {
+            std::cout << "FAIL: maze " << name << " transform " << transform
+                      << " canonicalizes to different planes" << std::endl;
+            failures++;
+        }
+
+        if(MazeSymmetry::hash(ns, ew) != maze.canonicalHash()) {
+            std::cout << "FAIL: maze " << name << " transform " << transform
+                      << " has a different canonical hash" << std::endl;
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+static unsigned testTranspose() {
+    unsigned failures = 0;
+
+    for(unsigned i = 0; i < 1000; i++) {
+        BitVector256 original;
+
+        for(unsigned x = 0; x < BitVector256::VECTOR_SIZE; x++) {
+            original.setBits(x, (uint16_t)rand());
+        }
+
+        BitVector256 transposed = original;
+        transposed.transpose();
+
+        for(unsigned x = 0; x < BitVector256::VECTOR_SIZE; x++) {
+            for(unsigned y = 0; y < BitVector256::VECTOR_SIZE; y++) {
+                if(transposed.get(x, y) != original.get(y, x)) {
+                    std::cout << "FAIL: transpose moved bit (" << y << ", " << x << ") to the wrong place" << std::endl;
+                    return failures + 1;
+                }
+            }
+        }
+
+        transposed.transpose();
+        if(transposed != original) {
+            std::cout << "FAIL: transposing twice did not restore the vector" << std::endl;
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+int main() {
+    unsigned failures = 0;
+
+    srand(26);
+
+    failures += testTranspose();
+
+    for(unsigned m = 0; m < MazeDefinitions::MAZE_NAME_MAX; m++) {
+        const MazeDefinitions::MazeEncodingName name = (MazeDefinitions::MazeEncodingName)m;
+        const MazeWalls maze(name);
+
+        failures += testApply(maze, name);
+        failures += testCanonicalize(maze, name);
+    }
+
+    std::cout << (failures ? "FAILED: " : "Passed: ") << failures << " failures" << std::endl;
+    return failures ? 1 : 0;
+}
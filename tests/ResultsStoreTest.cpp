@@ -0,0 +1,174 @@
+#include <iostream>
+#include <cstdio>   // fopen, remove
+#include <string>
+#include <vector>
+
+#include "../ResultsStore.h"
+
+/**
+ * Regression test for appending to and recovering results stores.
+ *
+ * Writes a store, reopens it to append more rows, then damages its end with junk
+ * or by cutting it short, and checks that readers and reopened writers always see
+ * the rows up to the last complete footer.
+ */
+
+static const char *STORE_PATH = "resultsstoretest.tmp";
+
+/**
+ * Appends count rows whose steps count up from firstStep.
+ */
+static bool appendRows(const std::string &finderName, uint32_t firstStep, unsigned count) {
+    ResultsWriter writer;
+
+    if(!writer.open(STORE_PATH)) {
+        return false;
+    }
+
+    const uint32_t finderId = writer.finderId(finderName);
+
+    for(unsigned i = 0; i < count; i++) {
+        ResultRow row;
+        row.mazeHash = 0x9e3779b97f4a7c15ULL * (firstStep + i);
+        row.finder = finderId;
+        row.steps = firstStep + i;
+
+        if(!writer.append(row)) {
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+static bool readFile(std::vector<unsigned char> &contents) {
+    FILE *file = fopen(STORE_PATH, "rb");
+    if(!file) {
+        return false;
+    }
+
+    unsigned char buffer[4096];
+    size_t read;
+
+    contents.clear();
+    while((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.insert(contents.end(), buffer, buffer + read);
+    }
+
+    fclose(file);
+    return true;
+}
+
+static bool writeFile(const std::vector<unsigned char> &contents) {
+    FILE *file = fopen(STORE_PATH, "wb");
+    if(!file) {
+        return false;
+    }
+
+    const bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    return (fclose(file) == 0) && written;
+}
+
+/**
+ * Checks that the store holds exactly the rows with steps 0 to rows - 1, in order.
+ */
+static bool expectRows(const char *stage, size_t rows, size_t finders) {
+    ResultsReader reader;
+
+    if(!reader.open(STORE_PATH)) {
+        std::cout << "FAIL: " << stage << ": store could not be read" << std::endl;
+        return false;
+    }
+
+    size_t found = 0;
+
+    for(size_t b = 0; b < reader.blockCount(); b++) {
+        ResultColumns columns;
+        reader.getBlock(b, columns);
+
+        for(size_t r = 0; r < columns.rows; r++, found++) {
+            if(columns.steps[r] != found || columns.mazeHash[r] != 0x9e3779b97f4a7c15ULL * found ||
+               columns.finder[r] >= reader.getFinderNames().size()) {
+                std::cout << "FAIL: " << stage << ": row " << found << " was not read back as written" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if(found != rows || reader.getFinderNames().size() != finders) {
+        std::cout << "FAIL: " << stage << ": found " << found << " rows and " << reader.getFinderNames().size()
+                  << " finders, expected " << rows << " and " << finders << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main() {
+    unsigned failures = 0;
+    std::vector<unsigned char> contents;
+
+    remove(STORE_PATH);
+
+    // More than a block, so the store ends with two footers
+    if(!appendRows("first", 0, 5000) || !expectRows("new store", 5000, 1)) {
+        failures++;
+    }
+
+    if(!appendRows("second", 5000, 3000) || !expectRows("reopened store", 8000, 2)) {
+        failures++;
+    }
+
+    // Junk after the last trailer, as left by a writer that died during a flush
+    if(!readFile(contents)) {
+        failures++;
+    }
+
+    const size_t completeSize = contents.size();
+    contents.insert(contents.end(), 1000, 0xA5);
+
+    if(!writeFile(contents) || !expectRows("store with junk", 8000, 2)) {
+        failures++;
+    }
+
+    if(!appendRows("first", 8000, 100) || !expectRows("store appended after junk", 8100, 2)) {
+        failures++;
+    }
+
+    // Cutting into the last trailer falls back to the footer before it
+    if(!readFile(contents)) {
+        failures++;
+    }
+
+    contents.resize(contents.size() - 3);
+
+    if(!writeFile(contents) || !expectRows("truncated store", 8000, 2)) {
+        failures++;
+    }
+
+    if(!appendRows("second", 8000, 10) || !expectRows("store appended after truncation", 8010, 2)) {
+        failures++;
+    }
+
+    // Cutting the store back to inside its first block leaves nothing to recover
+    contents.resize(completeSize / 100);
+
+    ResultsReader reader;
+    ResultsWriter writer;
+
+    if(!writeFile(contents) || reader.open(STORE_PATH) || writer.open(STORE_PATH)) {
+        std::cout << "FAIL: store without a complete footer was opened" << std::endl;
+        failures++;
+    }
+
+    std::vector<unsigned char> after;
+    if(!readFile(after) || after != contents) {
+        std::cout << "FAIL: invalid store was modified" << std::endl;
+        failures++;
+    }
+
+    remove(STORE_PATH);
+
+    std::cout << (failures ? "FAILED: " : "Passed: ") << failures << " failures" << std::endl;
+    return failures ? 1 : 0;
+}
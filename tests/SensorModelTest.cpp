@@ -0,0 +1,183 @@
+#include <iostream>
+
+#include "../Dir.h"
+#include "../Maze.h"
+#include "../MazeDefinitions.h"
+#include "../SensorModel.h"
+#include "../WallMap.h"
+
+/**
+ * Regression test for the range sensors.
+ *
+ * Checks Maze::openDistance against walking wall by wall with isOpen from every cell
+ * in every direction of every built in maze, and that readings taken through Maze::sense
+ * and recorded into a WallMap only ever record the real walls the sensors can reach.
+ */
+
+// Exposes the mouse and the wall queries of a maze to the test
+class MazeProbe : public Maze {
+public:
+    MazeProbe(MazeDefinitions::MazeEncodingName name) : Maze(name, NULL) {
+    }
+
+    inline void placeMouse(unsigned x, unsigned y, Dir d) {
+        mouseX = x;
+        mouseY = y;
+        heading = d;
+    }
+
+    using Maze::isOpen;
+    using Maze::openDistance;
+};
+
+static const Dir directions[] = { NORTH, SOUTH, EAST, WEST };
+static const unsigned directionCount = sizeof(directions) / sizeof(*directions);
+
+static bool step(unsigned &x, unsigned &y, Dir d) {
+    switch(d) {
+        case NORTH:
+            y++;
+            break;
+        case SOUTH:
+            y--;
+            break;
+        case EAST:
+            x++;
+            break;
+        case WEST:
+            x--;
+            break;
+        case INVALID:
+        default:
+            return false;
+    }
+
+    return x < MazeDefinitions::MAZE_LEN && y < MazeDefinitions::MAZE_LEN;
+}
+
+/**
+ * Counts open walls in a row one isOpen at a time.
+ */
+static unsigned walkOpen(const MazeProbe &maze, unsigned x, unsigned y, Dir d, unsigned maxCells) {
+    unsigned open = 0;
+
+    while(open < maxCells && maze.isOpen(x, y, d)) {
+        open++;
+
+        if(!step(x, y, d)) {
+            break;
+        }
+    }
+
+    return open;
+}
+
+static unsigned testOpenDistance(const MazeProbe &maze, MazeDefinitions::MazeEncodingName name) {
+    unsigned failures = 0;
+
+    for(unsigned x = 0; x < MazeDefinitions::MAZE_LEN; x++) {
+        for(unsigned y = 0; y < MazeDefinitions::MAZE_LEN; y++) {
+            for(unsigned i = 0; i < directionCount; i++) {
+                for(unsigned maxCells = 1; maxCells <= MazeDefinitions::MAZE_LEN; maxCells++) {
+                    const unsigned expected = walkOpen(maze, x, y, directions[i], maxCells);
+                    const unsigned actual = maze.openDistance(x, y, directions[i], maxCells);
+
+                    if(actual != expected) {
+                        std::cout << "FAIL: maze " << name << " cell (" << x << ", " << y << ") direction "
+                                  << directions[i] << " range " << maxCells << ": openDistance " << actual
+                                  << ", walked " << expected << std::endl;
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * Checks that the walls recorded along a ray are exactly the real walls a sensor of
+ * the given range sees from (x, y). The outer boundary always counts as known.
+ * @return false if any wall was missed, recorded wrongly or recorded out of range
+ */
+static bool checkRecordedRay(const MazeProbe &maze, const WallMap &map, unsigned x, unsigned y, Dir d, unsigned range) {
+    const unsigned open = walkOpen(maze, x, y, d, range);
+    const unsigned seen = (open < range) ? open + 1 : open;
+
+    for(unsigned i = 0; i < MazeDefinitions::MAZE_LEN; i++) {
+        unsigned nextX = x, nextY = y;
+        const bool boundary = !step(nextX, nextY, d);
+
+        if(i < seen) {
+            if(!map.isKnown(x, y, d) || map.isOpen(x, y, d) != maze.isOpen(x, y, d)) {
+                return false;
+            }
+        } else if(map.isKnown(x, y, d) && !boundary) {
+            return false;
+        }
+
+        if(boundary) {
+            break;
+        }
+
+        x = nextX;
+        y = nextY;
+    }
+
+    return true;
+}
+
+static unsigned testSense(MazeProbe &maze, MazeDefinitions::MazeEncodingName name, const SensorModel &sensors) {
+    unsigned failures = 0;
+
+    maze.setSensorModel(sensors);
+
+    for(unsigned x = 0; x < MazeDefinitions::MAZE_LEN; x++) {
+        for(unsigned y = 0; y < MazeDefinitions::MAZE_LEN; y++) {
+            for(unsigned i = 0; i < directionCount; i++) {
+                const Dir heading = directions[i];
+                SensorReading reading;
+                WallMap map;
+
+                maze.placeMouse(x, y, heading);
+                maze.sense(reading);
+                SensorModel::record(reading, x, y, heading, map);
+
+                bool ok = reading.front.openCells == walkOpen(maze, x, y, heading, sensors.getFrontRange());
+                ok = ok && reading.left.openCells == walkOpen(maze, x, y, counterClockwise(heading), sensors.getSideRange());
+                ok = ok && reading.right.openCells == walkOpen(maze, x, y, clockwise(heading), sensors.getSideRange());
+
+                ok = ok && checkRecordedRay(maze, map, x, y, heading, sensors.getFrontRange());
+                ok = ok && checkRecordedRay(maze, map, x, y, counterClockwise(heading), sensors.getSideRange());
+                ok = ok && checkRecordedRay(maze, map, x, y, clockwise(heading), sensors.getSideRange());
+
+                if(!ok) {
+                    std::cout << "FAIL: maze " << name << " cell (" << x << ", " << y << ") heading " << heading
+                              << " ranges " << sensors.getFrontRange() << "/" << sensors.getSideRange()
+                              << " sensed the wrong walls" << std::endl;
+                    failures++;
+                }
+            }
+        }
+    }
+
+    return failures;
+}
+
+int main() {
+    unsigned failures = 0;
+
+    for(unsigned m = 0; m < MazeDefinitions::MAZE_NAME_MAX; m++) {
+        const MazeDefinitions::MazeEncodingName name = (MazeDefinitions::MazeEncodingName)m;
+        MazeProbe maze(name);
+
+        failures += testOpenDistance(maze, name);
+        failures += testSense(maze, name, SensorModel(1, 1));
+        failures += testSense(maze, name, SensorModel(3, 2));
+        failures += testSense(maze, name, SensorModel());
+    }
+
+    std::cout << (failures ? "FAILED: " : "Passed: ") << failures << " failures" << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,213 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstring>  // strcmp
+#include <algorithm> // sort
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../ResultsStore.h"
+#include "../RunLimits.h"
+
+/**
+ * Aggregates results stores written by the simulator's -o option.
+ *
+ * Files are memory mapped and each block is scanned one column at a time.
+ * Groups are keyed on the raw finder id or maze hash, and only formatted for printing.
+ */
+
+struct Aggregate {
+    unsigned long runs;
+    unsigned long statusCounts[RUN_RESULT_MAX];
+    double steps;
+    double turns;
+    // Runs in which the mouse came to know an optimal path, and the sum of the steps it took
+    unsigned long explored;
+    double exploredStep;
+    double simTime;
+    double wallTime;
+
+    Aggregate() : runs(0), steps(0), turns(0), explored(0), exploredStep(0), simTime(0), wallTime(0) {
+        for(unsigned i = 0; i < RUN_RESULT_MAX; i++) {
+            statusCounts[i] = 0;
+        }
+    }
+};
+
+enum GroupBy {
+    GROUP_FINDER,
+    GROUP_MAZE
+};
+
+int main(int argc, char * argv[]) {
+    GroupBy groupBy = GROUP_FINDER;
+    std::vector<std::string> paths;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "-g") == 0 && i+1 < argc && strcmp(argv[i+1], "finder") == 0) {
+            groupBy = GROUP_FINDER;
+            i++;
+        } else if(strcmp(argv[i], "-g") == 0 && i+1 < argc && strcmp(argv[i+1], "maze") == 0) {
+            groupBy = GROUP_MAZE;
+            i++;
+        } else if(argv[i][0] != '-') {
+            paths.push_back(argv[i]);
+        } else {
+            paths.clear();
+            break;
+        }
+    }
+
+    if(paths.empty()) {
+        std::cout << "Usage: " << argv[0] << " [-g finder|maze] FILE..." << std::endl;
+        std::cout << "\t-g will group results by PathFinder name (default) or by maze hash" << std::endl;
+        return -1;
+    }
+
+    // Finder ids are per file, so they are mapped onto one list of names shared by all files
+    std::vector<std::string> finderNames;
+    std::map<std::string, uint32_t> finderIds;
+    std::vector<Aggregate> byFinder;
+    Aggregate unknownFinder;
+    std::unordered_map<uint64_t, Aggregate> byMaze;
+    std::vector<Aggregate *> rowGroups;
+
+    for(size_t p = 0; p < paths.size(); p++) {
+        ResultsReader reader;
+
+        if(!reader.open(paths[p])) {
+            std::cerr << "Unable to read results file " << paths[p] << std::endl;
+            return -1;
+        }
+
+        const std::vector<std::string> &fileFinders = reader.getFinderNames();
+        std::vector<uint32_t> globalFinder(fileFinders.size());
+
+        for(size_t f = 0; f < fileFinders.size(); f++) {
+            std::map<std::string, uint32_t>::iterator it = finderIds.find(fileFinders[f]);
+
+            if(it == finderIds.end()) {
+                it = finderIds.insert(std::make_pair(fileFinders[f], (uint32_t)finderNames.size())).first;
+                finderNames.push_back(fileFinders[f]);
+            }
+
+            globalFinder[f] = it->second;
+        }
+
+        byFinder.resize(finderNames.size());
+
+        for(size_t b = 0; b < reader.blockCount(); b++) {
+            ResultColumns columns;
+            reader.getBlock(b, columns);
+            rowGroups.resize(columns.rows);
+
+            // Resolve each row's group once, then sum up one column at a time
+            if(groupBy == GROUP_FINDER) {
+                for(size_t r = 0; r < columns.rows; r++) {
+                    const uint32_t id = columns.finder[r];
+                    rowGroups[r] = (id < globalFinder.size()) ? &byFinder[globalFinder[id]] : &unknownFinder;
+                }
+            } else {
+                for(size_t r = 0; r < columns.rows; r++) {
+                    rowGroups[r] = &byMaze[columns.mazeHash[r]];
+                }
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                rowGroups[r]->runs++;
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                rowGroups[r]->steps += columns.steps[r];
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                rowGroups[r]->turns += columns.turns[r];
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                if(columns.exploredStep[r] != ResultRow::NOT_EXPLORED) {
+                    rowGroups[r]->explored++;
+                    rowGroups[r]->exploredStep += columns.exploredStep[r];
+                }
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                rowGroups[r]->simTime += columns.simTime[r];
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                rowGroups[r]->wallTime += columns.wallTime[r];
+            }
+
+            for(size_t r = 0; r < columns.rows; r++) {
+                if(columns.status[r] < RUN_RESULT_MAX) {
+                    rowGroups[r]->statusCounts[columns.status[r]]++;
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string, const Aggregate *> > groups;
+
+    if(groupBy == GROUP_FINDER) {
+        for(size_t f = 0; f < byFinder.size(); f++) {
+            if(byFinder[f].runs > 0) {
+                groups.push_back(std::make_pair(finderNames[f], &byFinder[f]));
+            }
+        }
+
+        // Rows whose finder id is missing from their file's footer
+        if(unknownFinder.runs > 0) {
+            groups.push_back(std::make_pair(std::string("?"), &unknownFinder));
+        }
+    } else {
+        std::vector<uint64_t> hashes;
+        for(std::unordered_map<uint64_t, Aggregate>::const_iterator it = byMaze.begin(); it != byMaze.end(); ++it) {
+            hashes.push_back(it->first);
+        }
+
+        std::sort(hashes.begin(), hashes.end());
+
+        for(size_t h = 0; h < hashes.size(); h++) {
+            std::ostringstream hash;
+            hash << std::hex << std::setw(16) << std::setfill('0') << hashes[h];
+            groups.push_back(std::make_pair(hash.str(), &byMaze[hashes[h]]));
+        }
+    }
+
+    std::cout << std::left << std::setw(20) << (groupBy == GROUP_FINDER ? "finder" : "maze")
+              << std::right << std::setw(10) << "runs";
+
+    for(unsigned s = 0; s < RUN_RESULT_MAX; s++) {
+        std::cout << std::setw(12) << runResultName((RunResult)s);
+    }
+
+    std::cout << std::setw(12) << "avg steps" << std::setw(12) << "avg turns"
+              << std::setw(12) << "opt known" << std::setw(12) << "avg known"
+              << std::setw(12) << "avg sim s" << std::setw(12) << "wall s" << std::endl;
+
+    for(size_t g = 0; g < groups.size(); g++) {
+        const Aggregate &aggregate = *groups[g].second;
+
+        std::cout << std::left << std::setw(20) << groups[g].first
+                  << std::right << std::setw(10) << aggregate.runs;
+
+        for(unsigned s = 0; s < RUN_RESULT_MAX; s++) {
+            std::cout << std::setw(12) << aggregate.statusCounts[s];
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(12) << aggregate.steps / aggregate.runs
+                  << std::setw(12) << aggregate.turns / aggregate.runs
+                  << std::setw(12) << aggregate.explored
+                  << std::setw(12) << (aggregate.explored ? aggregate.exploredStep / aggregate.explored : 0.0)
+                  << std::setw(12) << aggregate.simTime / aggregate.runs
+                  << std::setw(12) << std::setprecision(4) << aggregate.wallTime
+                  << std::endl;
+    }
+
+    return 0;
+}